@@ -0,0 +1,165 @@
+"""
+Benchmark and equivalence check of C++ and Python readers in `pybes3.io.root_io`.
+
+Every branch in `bes3_branch2types` found in the input files is decoded basket by basket
+with both backends. Throughput (MB/s, events/s) is reported per branch and backend, and
+the script exits with non-zero status if the two backends give different arrays.
+
+Usage:
+    python dev/benchmark-root-io.py [files ...] [--scale N] [--repeat N]
+
+Without files, the test files in `tests/data` are used. `--scale N` concatenates each
+basket N times to emulate larger inputs, as long as each basket stays below 4 GiB.
+"""
+
+from __future__ import annotations
+
+import argparse
+import sys
+import time
+from pathlib import Path
+
+import awkward as ak
+import numpy as np
+import uproot
+import uproot_custom.readers.python
+from uproot_custom import build_factory, regularize_object_path
+
+import pybes3  # noqa: F401
+from pybes3.io.root_io import bes3_branch2types
+from pybes3.kernels import _io as bcpp
+
+TEST_DATA_DIR = Path(__file__).parent.parent / "tests" / "data"
+DEFAULT_FILES = [
+    TEST_DATA_DIR / "test_full_mc_evt_1.rtraw",
+    TEST_DATA_DIR / "test_full_mc_evt_1.dst",
+    TEST_DATA_DIR / "test_full_mc_evt_1.rec",
+    TEST_DATA_DIR / "test_cgem.rtraw",
+    TEST_DATA_DIR / "test_cgem.dst",
+    TEST_DATA_DIR / "test_cgem.rec",
+]
+
+
+def get_all_streamer_info(file) -> dict[str, list[dict]]:
+    res = {}
+    for name, versions in file.streamers.items():
+        streamer = next(iter(versions.values()))
+        res[name] = [e.all_members for e in streamer.member("fElements")]
+    return res
+
+
+# `read_data` takes uint32 entry offsets, as ROOT baskets do
+MAX_BASKET_BYTES = np.iinfo(np.uint32).max
+
+
+def get_baskets(branch, scale: int) -> list[tuple[np.ndarray, np.ndarray]]:
+    baskets = []
+    for i in range(branch.num_baskets):
+        basket = branch.basket(i)
+        data = np.asarray(basket.data, dtype=np.uint8)
+        offsets = np.asarray(basket.byte_offsets, dtype=np.int64)
+
+        if scale * offsets[-1] > MAX_BASKET_BYTES:
+            raise ValueError(
+                f"--scale {scale} makes a basket of {branch.name} {scale * offsets[-1]} bytes "
+                f"long, over the {MAX_BASKET_BYTES} bytes that entry offsets can address"
+            )
+
+        if scale > 1:
+            data = np.tile(data, scale)
+            shifts = np.repeat(
+                np.arange(scale, dtype=np.int64) * offsets[-1], len(offsets) - 1
+            )
+            offsets = np.append(np.tile(offsets[:-1], scale) + shifts, scale * offsets[-1])
+
+        baskets.append((data, offsets))
+    return baskets
+
+
+def read_cpp(factory, data, offsets):
+    reader = factory.build_cpp_reader()
+    # safe, `get_baskets` checks that the offsets fit
+    uint32_offsets = offsets.astype(np.uint32)
+    return factory.make_awkward_content(bcpp.read_data(data, uint32_offsets, reader))
+
+
+def read_python(factory, data, offsets):
+    reader = factory.build_python_reader()
+    stream = uproot_custom.readers.python.BinaryStream(data, offsets)
+    for _ in range(len(offsets) - 1):
+        reader.read(stream)
+    return factory.make_awkward_content(reader.data())
+
+
+def benchmark(read_func, factory, baskets, repeat: int):
+    best = np.inf
+    for _ in range(repeat):
+        start = time.perf_counter()
+        contents = [read_func(factory, data, offsets) for data, offsets in baskets]
+        best = min(best, time.perf_counter() - start)
+
+    arr = ak.concatenate([ak.Array(c) for c in contents]) if contents else ak.Array([])
+    return arr, best
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument("files", nargs="*", type=Path, default=DEFAULT_FILES)
+    parser.add_argument("--scale", type=int, default=1, help="Replicate each basket N times")
+    parser.add_argument("--repeat", type=int, default=3, help="Take the best of N runs")
+    parser.add_argument("--skip-python", action="store_true", help="Only run C++ readers")
+    args = parser.parse_args()
+
+    n_mismatch = 0
+    header = f"{'branch':<45} {'backend':<7} {'MB/s':>10} {'events/s':>12} {'speedup':>8}"
+
+    for file_path in args.files:
+        f = uproot.open(file_path)
+        tree = f["Event"]
+        all_streamer_info = get_all_streamer_info(f)
+
+        print(f"\n{file_path.name} (scale={args.scale})")
+        print(header)
+        print("-" * len(header))
+
+        for branch in tree.itervalues(recursive=True):
+            item_path = regularize_object_path(branch.object_path)
+            if item_path not in bes3_branch2types:
+                continue
+
+            factory = build_factory(branch.streamer.all_members, all_streamer_info, item_path)
+            baskets = get_baskets(branch, args.scale)
+            n_bytes = sum(d.nbytes for d, _ in baskets) / 1024 / 1024
+            n_events = sum(len(o) - 1 for _, o in baskets)
+            name = item_path.replace("/Event:", "")
+
+            cpp_arr, cpp_time = benchmark(read_cpp, factory, baskets, args.repeat)
+            print(
+                f"{name:<45} {'C++':<7} {n_bytes / cpp_time:>10.1f} "
+                f"{n_events / cpp_time:>12.0f} {'':>8}"
+            )
+
+            if args.skip_python:
+                continue
+
+            py_arr, py_time = benchmark(read_python, factory, baskets, args.repeat)
+            print(
+                f"{name:<45} {'Python':<7} {n_bytes / py_time:>10.1f} "
+                f"{n_events / py_time:>12.0f} {py_time / cpp_time:>7.1f}x"
+            )
+
+            if not ak.array_equal(cpp_arr, py_arr, equal_nan=True):
+                n_mismatch += 1
+                print(f"MISMATCH: {name}", file=sys.stderr)
+
+    if n_mismatch > 0:
+        print(
+            f"\n{n_mismatch} branch(es) differ between C++ and Python readers", file=sys.stderr
+        )
+        return 1
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
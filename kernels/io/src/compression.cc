@@ -0,0 +1,172 @@
+#include <cstring>
+#include <stdexcept>
+
+#ifdef PYBES3_WITH_ZLIB
+#    include <zlib.h>
+#endif
+
+#ifdef PYBES3_WITH_LZMA
+#    include <lzma.h>
+#endif
+
+#ifdef PYBES3_WITH_LZ4
+#    include <lz4.h>
+#endif
+
+#ifdef PYBES3_WITH_ZSTD
+#    include <zstd.h>
+#endif
+
+#include "compression.hh"
+
+namespace {
+    [[noreturn]] void throw_block_error( const char* algo, const std::string& msg ) {
+        throw std::runtime_error( std::string( "Failed to decompress " ) + algo +
+                                  " block: " + msg );
+    }
+
+#ifdef PYBES3_WITH_ZLIB
+    void inflate_zlib( const uint8_t* src, size_t src_size, uint8_t* dst, size_t dst_size ) {
+        z_stream strm{};
+        if ( inflateInit( &strm ) != Z_OK ) throw_block_error( "ZLIB", "inflateInit failed" );
+
+        strm.next_in   = const_cast<Bytef*>( src );
+        strm.avail_in  = static_cast<uInt>( src_size );
+        strm.next_out  = dst;
+        strm.avail_out = static_cast<uInt>( dst_size );
+
+        auto ret = inflate( &strm, Z_FINISH );
+        auto n   = strm.total_out;
+        inflateEnd( &strm );
+
+        if ( ret != Z_STREAM_END || n != dst_size )
+            throw_block_error( "ZLIB", "inflate returned " + std::to_string( ret ) );
+    }
+#endif
+
+#ifdef PYBES3_WITH_LZMA
+    void decode_lzma( const uint8_t* src, size_t src_size, uint8_t* dst, size_t dst_size ) {
+        uint64_t memlimit = UINT64_MAX;
+        size_t in_pos     = 0;
+        size_t out_pos    = 0;
+
+        auto ret = lzma_stream_buffer_decode( &memlimit, 0, nullptr, src, &in_pos, src_size,
+                                              dst, &out_pos, dst_size );
+        if ( ret != LZMA_OK || out_pos != dst_size )
+            throw_block_error( "LZMA", "lzma_stream_buffer_decode returned " +
+                                           std::to_string( ret ) );
+    }
+#endif
+
+#ifdef PYBES3_WITH_LZ4
+    void decode_lz4( const uint8_t* src, size_t src_size, uint8_t* dst, size_t dst_size ) {
+        // the block starts with a 8-byte xxhash64 checksum, which is not verified here
+        if ( src_size < ROOT_LZ4_CHECKSUM_SIZE ) throw_block_error( "LZ4", "block too short" );
+
+        auto n = LZ4_decompress_safe(
+            reinterpret_cast<const char*>( src + ROOT_LZ4_CHECKSUM_SIZE ),
+            reinterpret_cast<char*>( dst ),
+            static_cast<int>( src_size - ROOT_LZ4_CHECKSUM_SIZE ),
+            static_cast<int>( dst_size ) );
+        if ( n < 0 || static_cast<size_t>( n ) != dst_size )
+            throw_block_error( "LZ4", "LZ4_decompress_safe returned " + std::to_string( n ) );
+    }
+#endif
+
+#ifdef PYBES3_WITH_ZSTD
+    void decode_zstd( const uint8_t* src, size_t src_size, uint8_t* dst, size_t dst_size ) {
+        auto n = ZSTD_decompress( dst, dst_size, src, src_size );
+        if ( ZSTD_isError( n ) || n != dst_size )
+            throw_block_error( "ZSTD", ZSTD_isError( n ) ? ZSTD_getErrorName( n )
+                                                         : "size mismatch" );
+    }
+#endif
+
+    inline size_t read_uint24( const uint8_t* p ) {
+        return static_cast<size_t>( p[0] ) | ( static_cast<size_t>( p[1] ) << 8 ) |
+               ( static_cast<size_t>( p[2] ) << 16 );
+    }
+
+    void decompress_block( const std::string& algo, const uint8_t* src, size_t src_size,
+                           uint8_t* dst, size_t dst_size ) {
+#ifdef PYBES3_WITH_ZLIB
+        if ( algo == "ZL" ) return inflate_zlib( src, src_size, dst, dst_size );
+#endif
+#ifdef PYBES3_WITH_LZMA
+        if ( algo == "XZ" ) return decode_lzma( src, src_size, dst, dst_size );
+#endif
+#ifdef PYBES3_WITH_LZ4
+        if ( algo == "L4" ) return decode_lz4( src, src_size, dst, dst_size );
+#endif
+#ifdef PYBES3_WITH_ZSTD
+        if ( algo == "ZS" ) return decode_zstd( src, src_size, dst, dst_size );
+#endif
+        throw std::runtime_error( "Unsupported ROOT compression algorithm: " + algo );
+    }
+} // namespace
+
+void decompress_root_blocks( const uint8_t* src, size_t src_size, uint8_t* dst,
+                             size_t dst_size ) {
+    size_t in_pos  = 0;
+    size_t out_pos = 0;
+
+    while ( in_pos < src_size )
+    {
+        if ( src_size - in_pos < ROOT_BLOCK_HEADER_SIZE )
+            throw std::runtime_error( "Truncated ROOT compression header" );
+
+        const uint8_t* header = src + in_pos;
+        auto block_src_size   = read_uint24( header + 3 );
+        auto block_dst_size   = read_uint24( header + 6 );
+
+        const uint8_t* block_src = header + ROOT_BLOCK_HEADER_SIZE;
+        uint8_t* block_dst       = dst + out_pos;
+
+        if ( in_pos + ROOT_BLOCK_HEADER_SIZE + block_src_size > src_size )
+            throw std::runtime_error( "Truncated ROOT compressed block" );
+        if ( out_pos + block_dst_size > dst_size )
+            throw std::runtime_error( "ROOT compressed block exceeds uncompressed size" );
+
+        std::string algo( reinterpret_cast<const char*>( header ), 2 );
+        decompress_block( algo, block_src, block_src_size, block_dst, block_dst_size );
+
+        in_pos += ROOT_BLOCK_HEADER_SIZE + block_src_size;
+        out_pos += block_dst_size;
+    }
+
+    if ( out_pos != dst_size )
+        throw std::runtime_error( "Decompressed " + std::to_string( out_pos ) +
+                                  " bytes, expected " + std::to_string( dst_size ) );
+}
+
+std::vector<std::string> supported_compressions() {
+    std::vector<std::string> res;
+#ifdef PYBES3_WITH_ZLIB
+    res.push_back( "ZLIB" );
+#endif
+#ifdef PYBES3_WITH_LZMA
+    res.push_back( "LZMA" );
+#endif
+#ifdef PYBES3_WITH_LZ4
+    res.push_back( "LZ4" );
+#endif
+#ifdef PYBES3_WITH_ZSTD
+    res.push_back( "ZSTD" );
+#endif
+    return res;
+}
+
+py::array_t<uint8_t> py_decompress( CompressedBuffer data, size_t uncompressed_bytes ) {
+    py::array_t<uint8_t> res( uncompressed_bytes );
+
+    auto src      = data.data();
+    auto src_size = static_cast<size_t>( data.size() );
+    auto dst      = res.mutable_data();
+
+    {
+        py::gil_scoped_release release;
+        decompress_root_blocks( src, src_size, dst, uncompressed_bytes );
+    }
+
+    return res;
+}
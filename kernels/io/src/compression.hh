@@ -0,0 +1,25 @@
+#pragma once
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace py = pybind11;
+
+// ROOT compressed buffers are sequences of blocks, each starting with a 9-byte header:
+// algorithm (2), method (1), compressed size (3), uncompressed size (3).
+constexpr size_t ROOT_BLOCK_HEADER_SIZE = 9;
+constexpr size_t ROOT_LZ4_CHECKSUM_SIZE = 8;
+
+using CompressedBuffer = py::array_t<uint8_t, py::array::c_style | py::array::forcecast>;
+
+void decompress_root_blocks( const uint8_t* src, size_t src_size, uint8_t* dst,
+                             size_t dst_size );
+
+std::vector<std::string> supported_compressions();
+
+py::array_t<uint8_t> py_decompress( CompressedBuffer data, size_t uncompressed_bytes );
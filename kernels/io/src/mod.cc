@@ -6,6 +6,7 @@
 #include <string>
 #include <vector>
 
+#include "compression.hh"
 #include "raw_io.hh"
 #include "root_io.hh"
 
@@ -18,9 +19,16 @@ PYBIND11_MODULE( _io, m ) {
            py::arg( "fields" )      = std::vector<std::string>(),
            py::arg( "info_tables" ) = std::map<std::string, py::array>() );
 
+    // ROOT basket decompression
+    m.def( "supported_compressions", &supported_compressions,
+           "Compression algorithms supported by native decompression" );
+    m.def( "decompress", &py_decompress, "Decompress ROOT compressed buffer",
+           py::arg( "data" ), py::arg( "uncompressed_bytes" ) );
+
     // BES3 reader
     declare_reader<Bes3TObjArrayReader, std::string, SharedReader>( m, "Bes3TObjArrayReader" );
     declare_reader<Bes3SymMatrixArrayReader<double>, std::string, uint32_t, uint32_t>(
         m, "Bes3SymMatrixArrayReader" );
     declare_reader<Bes3CgemClusterColReader, std::string>( m, "Bes3CgemClusterColReader" );
+    declare_reader<Bes3EvtNavigatorMapReader, std::string>( m, "Bes3EvtNavigatorMapReader" );
 }
@@ -226,7 +226,7 @@ class RawBinaryParser {
     } m_evt_header_data;
 
     /* MDC */
-    SharedVector<uint32_t> m_mdc_offsets{ make_shared_vector<uint32_t>() };
+    SharedVector<int64_t> m_mdc_offsets{ make_shared_vector<int64_t>() };
     array<array<uint32_t, 4>, 16384> m_mdc_tags{};
 
     struct {
@@ -253,7 +253,7 @@ class RawBinaryParser {
     }
 
     /* TOF */
-    SharedVector<uint32_t> m_tof_offsets{ make_shared_vector<uint32_t>() };
+    SharedVector<int64_t> m_tof_offsets{ make_shared_vector<int64_t>() };
     struct {
         SharedVector<uint32_t> id{ make_shared_vector<uint32_t>() };
         SharedVector<uint32_t> tdc{ make_shared_vector<uint32_t>() };
@@ -263,7 +263,7 @@ class RawBinaryParser {
     } m_tof_data;
 
     /* EMC */
-    SharedVector<uint32_t> m_emc_offsets{ make_shared_vector<uint32_t>() };
+    SharedVector<int64_t> m_emc_offsets{ make_shared_vector<int64_t>() };
     struct {
         SharedVector<uint32_t> id{ make_shared_vector<uint32_t>() };
         SharedVector<uint32_t> tdc{ make_shared_vector<uint32_t>() };
@@ -274,14 +274,14 @@ class RawBinaryParser {
 
     /* MUC */
     uint32_t* m_muc_strsqc{ nullptr };
-    SharedVector<uint32_t> m_muc_offsets{ make_shared_vector<uint32_t>() };
+    SharedVector<int64_t> m_muc_offsets{ make_shared_vector<int64_t>() };
     struct {
         SharedVector<uint32_t> id{ make_shared_vector<uint32_t>() };
         size_t size() const { return id->size(); }
     } m_muc_data;
 
     /* TrigGTD */
-    SharedVector<uint32_t> m_trg_offsets{ make_shared_vector<uint32_t>() };
+    SharedVector<int64_t> m_trg_offsets{ make_shared_vector<int64_t>() };
     struct {
         SharedVector<uint32_t> id{ make_shared_vector<uint32_t>() };
         SharedVector<uint32_t> data_size{ make_shared_vector<uint32_t>() };
@@ -291,7 +291,7 @@ class RawBinaryParser {
     } m_trg_data;
 
     /* LUMI */
-    SharedVector<uint32_t> m_lumi_offsets{ make_shared_vector<uint32_t>() };
+    SharedVector<int64_t> m_lumi_offsets{ make_shared_vector<int64_t>() };
     struct {
         SharedVector<uint32_t> id{ make_shared_vector<uint32_t>() };
         SharedVector<uint32_t> tdc{ make_shared_vector<uint32_t>() };
@@ -311,7 +311,7 @@ class RawBinaryParser {
         uint32_t* idx_to_digi_id{ nullptr };
     } m_cgem_table;
 
-    SharedVector<uint32_t> m_cgem_offsets{ make_shared_vector<uint32_t>() };
+    SharedVector<int64_t> m_cgem_offsets{ make_shared_vector<int64_t>() };
 
     struct {
         SharedVector<uint32_t> id{ make_shared_vector<uint32_t>() };
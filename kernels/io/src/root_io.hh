@@ -15,13 +15,13 @@ SharedVector<T> make_shared_vector( Args&&... args ) {
 class Bes3TObjArrayReader : public IReader {
   private:
     SharedReader m_element_reader;
-    SharedVector<uint32_t> m_offsets;
+    SharedVector<int64_t> m_offsets;
 
   public:
     Bes3TObjArrayReader( std::string name, SharedReader element_reader )
         : IReader( name )
         , m_element_reader( element_reader )
-        , m_offsets( make_shared_vector<uint32_t>( 1, 0 ) ) {}
+        , m_offsets( make_shared_vector<int64_t>( 1, 0 ) ) {}
 
     void read( BinaryStream& stream ) override {
         debug_printf( "Bes3TObjArrayReader %s: reading...\n", m_name.c_str() );
@@ -117,7 +117,7 @@ class Bes3CgemClusterColReader : public IReader {
   private:
     int m_version{ -1 }; // -1: unknown, 0: with recpositiony, 1: without recpositiony
 
-    SharedVector<uint32_t> m_offsets;
+    SharedVector<int64_t> m_offsets;
     SharedVector<int32_t> m_clusterid;
     SharedVector<int32_t> m_trkid;
     SharedVector<int32_t> m_layerid;
@@ -134,7 +134,7 @@ class Bes3CgemClusterColReader : public IReader {
   public:
     Bes3CgemClusterColReader( std::string name )
         : IReader( name )
-        , m_offsets( make_shared_vector<uint32_t>( 1, 0 ) )
+        , m_offsets( make_shared_vector<int64_t>( 1, 0 ) )
         , m_clusterid( make_shared_vector<int32_t>() )
         , m_trkid( make_shared_vector<int32_t>() )
         , m_layerid( make_shared_vector<int32_t>() )
@@ -224,3 +224,55 @@ class Bes3CgemClusterColReader : public IReader {
         return result;
     }
 };
+
+class Bes3EvtNavigatorMapReader : public IReader {
+  private:
+    // ROOT streams STL containers member-wise when this bit is set in fVersion
+    static constexpr uint16_t kStreamedMemberWise = 0x4000;
+
+    SharedVector<int64_t> m_offsets;
+    SharedVector<int32_t> m_key;
+    SharedVector<int32_t> m_val;
+
+  public:
+    Bes3EvtNavigatorMapReader( std::string name )
+        : IReader( name )
+        , m_offsets( make_shared_vector<int64_t>( 1, 0 ) )
+        , m_key( make_shared_vector<int32_t>() )
+        , m_val( make_shared_vector<int32_t>() ) {}
+
+    void read( BinaryStream& stream ) override {
+        debug_printf( "Bes3EvtNavigatorMapReader %s: reading...\n", m_name.c_str() );
+        debug_printf( stream );
+
+        stream.skip_fNBytes();
+        auto fVersion = stream.read<uint16_t>();
+
+        bool is_memberwise = fVersion & kStreamedMemberWise;
+        if ( is_memberwise ) stream.skip( 6 ); // class version + checksum
+
+        auto fSize = stream.read<uint32_t>();
+        m_offsets->push_back( m_offsets->back() + fSize );
+
+        if ( is_memberwise )
+        {
+            for ( uint32_t i = 0; i < fSize; i++ ) m_key->push_back( stream.read<int32_t>() );
+            for ( uint32_t i = 0; i < fSize; i++ ) m_val->push_back( stream.read<int32_t>() );
+        }
+        else
+        {
+            for ( uint32_t i = 0; i < fSize; i++ )
+            {
+                m_key->push_back( stream.read<int32_t>() );
+                m_val->push_back( stream.read<int32_t>() );
+            }
+        }
+    }
+
+    py::object data() const override {
+        auto offsets_array = make_array( m_offsets );
+        auto key_array     = make_array( m_key );
+        auto val_array     = make_array( m_val );
+        return py::make_tuple( offsets_array, key_array, val_array );
+    }
+};
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// ===========================================================================
+// Bit layout of the digi IDs
+// ===========================================================================
+constexpr uint32_t DIGI_MDC_FLAG    = 0x10;
+constexpr uint32_t DIGI_TOF_FLAG    = 0x20;
+constexpr uint32_t DIGI_EMC_FLAG    = 0x30;
+constexpr uint32_t DIGI_MUC_FLAG    = 0x40;
+constexpr uint32_t DIGI_CGEM_FLAG   = 0x60;
+constexpr uint32_t DIGI_FLAG_OFFSET = 24;
+constexpr uint32_t DIGI_FLAG_MASK   = 0xFF000000;
+
+constexpr uint32_t DIGI_MDC_WIRETYPE_OFFSET = 15;
+constexpr uint32_t DIGI_MDC_WIRETYPE_MASK   = 0x00008000;
+constexpr uint32_t DIGI_MDC_LAYER_OFFSET    = 9;
+constexpr uint32_t DIGI_MDC_LAYER_MASK      = 0x00007E00;
+constexpr uint32_t DIGI_MDC_WIRE_OFFSET     = 0;
+constexpr uint32_t DIGI_MDC_WIRE_MASK       = 0x000001FF;
+constexpr uint32_t DIGI_MDC_STEREO_WIRE     = 1;
+
+constexpr uint32_t DIGI_TOF_PART_OFFSET = 14;
+constexpr uint32_t DIGI_TOF_PART_MASK   = 0x0000C000;
+constexpr uint32_t DIGI_TOF_END_OFFSET  = 0;
+constexpr uint32_t DIGI_TOF_END_MASK    = 0x00000001;
+
+constexpr uint32_t DIGI_TOF_SCINT_LAYER_OFFSET = 8;
+constexpr uint32_t DIGI_TOF_SCINT_LAYER_MASK   = 0x00000100;
+constexpr uint32_t DIGI_TOF_SCINT_PHI_OFFSET   = 1;
+constexpr uint32_t DIGI_TOF_SCINT_PHI_MASK     = 0x000000FE;
+
+constexpr uint32_t DIGI_TOF_MRPC_ENDCAP_OFFSET = 11;
+constexpr uint32_t DIGI_TOF_MRPC_ENDCAP_MASK   = 0x00000800;
+constexpr uint32_t DIGI_TOF_MRPC_MODULE_OFFSET = 5;
+constexpr uint32_t DIGI_TOF_MRPC_MODULE_MASK   = 0x000007E0;
+constexpr uint32_t DIGI_TOF_MRPC_STRIP_OFFSET  = 1;
+constexpr uint32_t DIGI_TOF_MRPC_STRIP_MASK    = 0x0000001E;
+
+constexpr uint32_t DIGI_EMC_MODULE_OFFSET = 16;
+constexpr uint32_t DIGI_EMC_MODULE_MASK   = 0x000F0000;
+constexpr uint32_t DIGI_EMC_THETA_OFFSET  = 8;
+constexpr uint32_t DIGI_EMC_THETA_MASK    = 0x00003F00;
+constexpr uint32_t DIGI_EMC_PHI_OFFSET    = 0;
+constexpr uint32_t DIGI_EMC_PHI_MASK      = 0x000000FF;
+
+constexpr uint32_t DIGI_MUC_PART_OFFSET    = 16;
+constexpr uint32_t DIGI_MUC_PART_MASK      = 0x000F0000;
+constexpr uint32_t DIGI_MUC_SEGMENT_OFFSET = 12;
+constexpr uint32_t DIGI_MUC_SEGMENT_MASK   = 0x0000F000;
+constexpr uint32_t DIGI_MUC_LAYER_OFFSET   = 8;
+constexpr uint32_t DIGI_MUC_LAYER_MASK     = 0x00000F00;
+constexpr uint32_t DIGI_MUC_CHANNEL_OFFSET = 0;
+constexpr uint32_t DIGI_MUC_CHANNEL_MASK   = 0x000000FF;
+
+constexpr uint32_t DIGI_CGEM_STRIP_OFFSET     = 7;
+constexpr uint32_t DIGI_CGEM_STRIP_MASK       = 0x0007FF80;
+constexpr uint32_t DIGI_CGEM_STRIPTYPE_OFFSET = 6;
+constexpr uint32_t DIGI_CGEM_STRIPTYPE_MASK   = 0x00000040;
+constexpr uint32_t DIGI_CGEM_SHEET_OFFSET     = 3;
+constexpr uint32_t DIGI_CGEM_SHEET_MASK       = 0x00000038;
+constexpr uint32_t DIGI_CGEM_LAYER_OFFSET     = 0;
+constexpr uint32_t DIGI_CGEM_LAYER_MASK       = 0x00000007;
+
+// ===========================================================================
+// Direct digi ID -> gid lookup
+//
+// The bits of a digi ID are split into a row index (high bits) and a local index (low
+// bits), such that the channels of a row have consecutive gids. A row table, indexed by
+// the row bits, stores the first gid and the number of channels of each row, so that a
+// digi ID is converted to gid with one gather and one comparison. Rows without channels
+// have `n_gids == 0`, which makes any ID of them invalid (-1).
+// ===========================================================================
+struct DigiRow {
+    uint16_t first_gid = 0;
+    uint16_t n_gids    = 0;
+};
+
+struct DigiLayout {
+    uint32_t flag;
+    uint32_t row_mask;
+    uint32_t row_offset;
+    uint32_t local_mask;
+    uint32_t local_offset;
+};
+
+template <DigiLayout L>
+using DigiRows = std::array<DigiRow, ( L.row_mask >> L.row_offset ) + 1>;
+
+// Register channel `gid` with `digi_id` (flag bits not needed) into the row table.
+template <DigiLayout L>
+consteval void add_digi_row( DigiRows<L>& rows, uint32_t digi_id, size_t gid ) {
+    auto& row     = rows[( digi_id & L.row_mask ) >> L.row_offset];
+    uint32_t loc  = ( digi_id & L.local_mask ) >> L.local_offset;
+    row.first_gid = static_cast<uint16_t>( gid - loc );
+    row.n_gids    = std::max<uint16_t>( row.n_gids, static_cast<uint16_t>( loc + 1 ) );
+}
+
+template <DigiLayout L, typename T>
+constexpr int64_t digi_row_gid( const DigiRows<L>& rows, T digi_id ) noexcept {
+    if ( ( static_cast<uint64_t>( digi_id ) >> DIGI_FLAG_OFFSET ) != L.flag ) return -1;
+
+    const auto& row = rows[( digi_id & L.row_mask ) >> L.row_offset];
+    uint32_t loc    = ( digi_id & L.local_mask ) >> L.local_offset;
+    return loc < row.n_gids ? static_cast<int64_t>( row.first_gid + loc ) : -1;
+}
+
+// Check that the rows map `digi_id(gid)` back to each of the `n` gids and to nothing
+// else, for a static_assert after building the table.
+template <DigiLayout L, typename F>
+consteval bool check_digi_rows( const DigiRows<L>& rows, size_t n, F digi_id ) {
+    size_t n_gids = 0;
+    for ( const auto& row : rows ) n_gids += row.n_gids;
+    if ( n_gids != n ) return false;
+
+    for ( size_t gid = 0; gid < n; ++gid )
+    {
+        uint32_t id = digi_id( gid ) | ( L.flag << DIGI_FLAG_OFFSET );
+        if ( digi_row_gid<L>( rows, id ) != static_cast<int64_t>( gid ) ) return false;
+    }
+    return true;
+}
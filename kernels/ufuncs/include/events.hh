@@ -0,0 +1,28 @@
+#pragma once
+
+#include "ufunc.hh"
+
+// ===========================================================================
+// Helpers of the per-event kernels, which take flat hit buffers and int64 event
+// offsets of them.
+// ===========================================================================
+
+// Check that `offsets` is a contiguous 1D int64 array of non-decreasing offsets from 0
+// to `n`. Sets a Python exception otherwise.
+static inline bool check_offsets( PyArrayObject* offsets, npy_intp n ) {
+    npy_intp n_events = PyArray_SIZE( offsets ) - 1;
+    if ( PyArray_TYPE( offsets ) != NPY_INT64 || PyArray_NDIM( offsets ) != 1 ||
+         !PyArray_IS_C_CONTIGUOUS( offsets ) || n_events < 0 )
+    {
+        PyErr_SetString( PyExc_ValueError, "offsets must be a contiguous 1D int64 array" );
+        return false;
+    }
+
+    auto poffsets = static_cast<const int64_t*>( PyArray_DATA( offsets ) );
+    bool valid    = poffsets[0] == 0 && poffsets[n_events] == n;
+    for ( npy_intp i = 0; i < n_events && valid; ++i ) valid = poffsets[i] <= poffsets[i + 1];
+
+    if ( !valid ) PyErr_SetString( PyExc_ValueError, "offsets do not match the inputs" );
+    return valid;
+}
+
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <numbers>
+
+// ===========================================================================
+// Angle constants shared by the detector and helix kernels
+// ===========================================================================
+constexpr double TWO_PI  = 2.0 * std::numbers::pi_v<double>;
+constexpr double HALF_PI = std::numbers::pi_v<double> / 2.0;
+
+// ===========================================================================
+// Per-channel geometry arrays, which stay `nan` until the geometry is loaded.
+// ===========================================================================
+template <size_t N>
+consteval std::array<double, N> _nan_array() {
+    std::array<double, N> arr{};
+    arr.fill( std::numeric_limits<double>::quiet_NaN() );
+    return arr;
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstdint>
+
+// ===========================================================================
+// Gid of a digi ID from the row table of each detector, the same as `xxx_id_to_gid`.
+// Return -1 if the digi ID is not of the detector or of none of its channels.
+// ===========================================================================
+int64_t mdc_digi_gid( uint64_t digi_id ) noexcept;
+int64_t tof_digi_gid( uint64_t digi_id ) noexcept;
+int64_t emc_digi_gid( uint64_t digi_id ) noexcept;
+int64_t muc_digi_gid( uint64_t digi_id ) noexcept;
+int64_t cgem_digi_gid( uint64_t digi_id ) noexcept;
@@ -0,0 +1,8 @@
+#pragma once
+
+#include "geom.hh"
+
+// ---------------------------------------------------------------------------
+// Constant: 1000 / 2.99792458  (for kappa -> radius conversion)
+// ---------------------------------------------------------------------------
+static constexpr double kKappaToRadiusFactor = 1000.0 / 2.99792458;
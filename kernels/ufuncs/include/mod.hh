@@ -12,6 +12,27 @@ void declare_helix( PyObject* d );
 void declare_identifier( PyObject* d );
 void declare_mdc( PyObject* d );
 void declare_tof( PyObject* d );
+void declare_muc( PyObject* d );
+void declare_reduce( PyObject* d );
 
+PyObject* _cgem_cluster_strips( PyObject* self, PyObject* args );
+PyObject* _cgem_xv_intersection( PyObject* self, PyObject* args );
 PyObject* _init_emc_geom( PyObject* self, PyObject* args );
+PyObject* _emc_match_crystals( PyObject* self, PyObject* args );
+PyObject* _emc_neighbours( PyObject* self, PyObject* args );
+PyObject* _emc_cluster_hits( PyObject* self, PyObject* args );
+PyObject* _emc_shower_shape( PyObject* self, PyObject* args );
 PyObject* _init_mdc_geom( PyObject* self, PyObject* args );
+PyObject* _init_muc_geom( PyObject* self, PyObject* args );
+
+PyObject* _init_tof_geom( PyObject* self, PyObject* args );
+PyObject* _tof_pair_ends( PyObject* self, PyObject* args );
+PyObject* _tof_predict_counters( PyObject* self, PyObject* args );
+
+PyObject* _reduce_events( PyObject* self, PyObject* args );
+PyObject* _fill_channel_hist( PyObject* self, PyObject* args );
+
+PyObject* _set_num_threads( PyObject* self, PyObject* args );
+PyObject* _get_num_threads( PyObject* self, PyObject* args );
+PyObject* _set_parallel_threshold( PyObject* self, PyObject* args );
+PyObject* _get_parallel_threshold( PyObject* self, PyObject* args );
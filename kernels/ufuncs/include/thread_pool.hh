@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ===========================================================================
+// ThreadPool
+//
+// Persistent worker threads used to split large contiguous ufunc loops. The pool is
+// created lazily and is disabled (1 thread) by default, so ufuncs stay single-threaded
+// unless `set_num_threads` is called.
+// ===========================================================================
+class ThreadPool {
+  public:
+    static ThreadPool& instance();
+
+    // Number of threads used by `parallel_for`, including the calling thread.
+    // `n == 0` means `std::thread::hardware_concurrency()`.
+    void set_num_threads( size_t n );
+    size_t num_threads() const { return m_num_threads; }
+
+    // Loops shorter than this number of elements run on the calling thread.
+    void set_threshold( int64_t n ) { m_threshold = n; }
+    int64_t threshold() const { return m_threshold; }
+
+    bool should_split( int64_t n ) const { return m_num_threads > 1 && n >= m_threshold; }
+
+    // Split [0, n) into chunks and call `fn(start, stop)` on each of them. The calling
+    // thread processes the first chunk, and returns when all chunks are done.
+    void parallel_for( int64_t n, const std::function<void( int64_t, int64_t )>& fn );
+
+  private:
+    ThreadPool() = default;
+
+    void resize_workers( size_t n_workers );
+    void worker_loop();
+
+    std::atomic<size_t> m_num_threads{ 1 };
+    std::atomic<int64_t> m_threshold{ 1 << 16 };
+
+    std::mutex m_resize_mutex;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<std::function<void()>> m_tasks;
+    std::vector<std::thread> m_workers;
+    bool m_stop{ false };
+    std::atomic<int64_t> m_pid{ 0 };
+};
@@ -12,6 +12,18 @@
 #include <tuple>
 #include <utility>
 
+#include "thread_pool.hh"
+
+// Runtime dispatch of the contiguous loops to AVX2/AVX-512 clones. Only GCC on x86-64
+// supports `target_clones` for template functions, other builds use the baseline ISA.
+#if defined( __GNUC__ ) && !defined( __clang__ ) && defined( __x86_64__ ) && \
+    defined( __linux__ )
+#    define PYBES3_TARGET_CLONES \
+        __attribute__( ( target_clones( "avx512f", "avx2", "default" ) ) )
+#else
+#    define PYBES3_TARGET_CLONES
+#endif
+
 // ===========================================================================
 // function_traits
 // ===========================================================================
@@ -78,9 +90,62 @@ struct cpp_to_numpy<bool> {
     static constexpr char value = NPY_BOOL;
 };
 
+template <typename T>
+struct remove_ptr {
+    using type = T;
+};
+template <typename T>
+struct remove_ptr<T*> {
+    using type = T;
+};
+template <typename T>
+using remove_ptr_t = typename remove_ptr<T>::type;
+
+// Typed loop for contiguous arguments. Pointer arithmetic on the real argument types
+// lets the compiler inline and auto-vectorise simple kernels.
+template <size_t NIN, size_t NOUT, auto F>
+PYBES3_TARGET_CLONES void ufunc_loop_contiguous( char** args, npy_intp n ) {
+    using traits = function_traits<decltype( F )>;
+
+    [&]<size_t... Is>( std::index_sequence<Is...> ) {
+        auto ptrs = std::make_tuple(
+            reinterpret_cast<std::tuple_element_t<Is, typename traits::args_tuple>>(
+                args[Is] )... );
+        for ( npy_intp i = 0; i < n; ++i ) F( ( std::get<Is>( ptrs ) + i )... );
+    }( std::make_index_sequence<NIN + NOUT>{} );
+}
+
 template <size_t NIN, size_t NOUT, auto F>
 void ufunc_loop( char** args, const npy_intp* dimensions, const npy_intp* steps, void* data ) {
     npy_intp n = dimensions[0];
+
+    // contiguous fast path: every step equals the size of its argument type
+    using traits    = function_traits<decltype( F )>;
+    using args_t    = typename traits::args_tuple;
+    bool contiguous = [&]<size_t... Is>( std::index_sequence<Is...> ) {
+        return ( ( steps[Is] == sizeof( remove_ptr_t<std::tuple_element_t<Is, args_t>> ) ) &&
+                 ... );
+    }( std::make_index_sequence<NIN + NOUT>{} );
+
+    if ( contiguous )
+    {
+        auto& pool = ThreadPool::instance();
+        if ( !pool.should_split( n ) )
+        {
+            ufunc_loop_contiguous<NIN, NOUT, F>( args, n );
+            return;
+        }
+
+        // large loops are split into chunks on the thread pool, see `set_num_threads`
+        pool.parallel_for( n, [args, steps]( int64_t start, int64_t stop ) {
+            char* chunk_args[NIN + NOUT];
+            for ( size_t i = 0; i < NIN + NOUT; ++i )
+                chunk_args[i] = args[i] + start * steps[i];
+            ufunc_loop_contiguous<NIN, NOUT, F>( chunk_args, stop - start );
+        } );
+        return;
+    }
+
     char* in[NIN];
     char* out[NOUT];
     npy_intp in_step[NIN];
@@ -113,17 +178,6 @@ void ufunc_loop( char** args, const npy_intp* dimensions, const npy_intp* steps,
     }
 }
 
-template <typename T>
-struct remove_ptr {
-    using type = T;
-};
-template <typename T>
-struct remove_ptr<T*> {
-    using type = T;
-};
-template <typename T>
-using remove_ptr_t = typename remove_ptr<T>::type;
-
 template <auto F>
 constexpr auto make_types() {
     using traits       = function_traits<decltype( F )>;
@@ -1,5 +1,13 @@
+#include <algorithm>
+#include <cmath>
+#include <numbers>
 #include <tuple>
+#include <utility>
+#include <vector>
 
+#include "events.hh"
+#include "digi.hh"
+#include "gid.hh"
 #include "mod.hh"
 #include "ufunc.hh"
 
@@ -65,6 +73,37 @@ inline void get_cgem_gid( T* layer, T* sheet, T* strip_type, T* strip, T* gid )
     *gid += *strip;
 }
 
+// digi ID -> gid: one row per (layer, sheet, strip type), strip is the local index
+constexpr DigiLayout CGEM_DIGI_LAYOUT = {
+    DIGI_CGEM_FLAG, DIGI_CGEM_LAYER_MASK | DIGI_CGEM_SHEET_MASK | DIGI_CGEM_STRIPTYPE_MASK,
+    DIGI_CGEM_LAYER_OFFSET, DIGI_CGEM_STRIP_MASK, DIGI_CGEM_STRIP_OFFSET };
+
+constexpr auto _cgem_digi_id = []( size_t gid ) -> uint32_t {
+    return ( _layer[gid] << DIGI_CGEM_LAYER_OFFSET ) |
+           ( _sheet[gid] << DIGI_CGEM_SHEET_OFFSET ) |
+           ( _strip_type[gid] << DIGI_CGEM_STRIPTYPE_OFFSET ) |
+           ( _strip[gid] << DIGI_CGEM_STRIP_OFFSET );
+};
+
+consteval auto _init_cgem_digi_rows() {
+    DigiRows<CGEM_DIGI_LAYOUT> rows{};
+    for ( size_t gid = 0; gid < N_STRIPS; ++gid )
+        add_digi_row<CGEM_DIGI_LAYOUT>( rows, _cgem_digi_id( gid ), gid );
+    return rows;
+}
+
+constexpr auto _cgem_digi_rows = _init_cgem_digi_rows();
+static_assert( check_digi_rows<CGEM_DIGI_LAYOUT>( _cgem_digi_rows, N_STRIPS, _cgem_digi_id ) );
+
+template <typename T>
+inline void cgem_id_to_gid( T* cgem_id, int64_t* gid ) noexcept {
+    *gid = digi_row_gid<CGEM_DIGI_LAYOUT>( _cgem_digi_rows, *cgem_id );
+}
+
+int64_t cgem_digi_gid( uint64_t digi_id ) noexcept {
+    return digi_row_gid<CGEM_DIGI_LAYOUT>( _cgem_digi_rows, digi_id );
+}
+
 template <typename T>
 inline void cgem_gid_to_layer( T* gid, T* layer ) noexcept {
     *layer = _layer[*gid];
@@ -95,6 +134,449 @@ inline void cgem_gid_to_is_vstrip( T* gid, bool* is_vstrip ) noexcept {
     *is_vstrip = _strip_type[*gid] == V_STRIP_TYPE;
 }
 
+template <typename T>
+inline void parse_cgem_gid( T* gid, T* layer, T* sheet, T* strip_type, T* strip,
+                            bool* is_xstrip, bool* is_vstrip ) noexcept {
+    *layer      = _layer[*gid];
+    *sheet      = _sheet[*gid];
+    *strip_type = _strip_type[*gid];
+    *strip      = _strip[*gid];
+    *is_xstrip  = _strip_type[*gid] == X_STRIP_TYPE;
+    *is_vstrip  = _strip_type[*gid] == V_STRIP_TYPE;
+}
+
+/*
+ * Strip groups for clustering. The X strips of a layer form one ring in phi over all its
+ * sheets, ordered by sheet then strip: strip 0 of a sheet follows the last strip of the
+ * previous sheet, and the last strip of the layer wraps around to strip 0 of sheet 0.
+ * The V strips of each sheet form a group without wrap. `_cluster_pos` is the position
+ * of a strip in its group.
+ */
+constexpr size_t N_CLUSTER_GROUPS = N_LAYER + N_SHEETS[0] + N_SHEETS[1] + N_SHEETS[2];
+
+consteval auto _init_cluster_groups() {
+    std::array<uint8_t, N_STRIPS> _cluster_group{};
+    std::array<uint16_t, N_STRIPS> _cluster_pos{};
+    std::array<uint16_t, N_CLUSTER_GROUPS> _group_size{};
+    std::array<bool, N_CLUSTER_GROUPS> _group_wraps{};
+
+    size_t v_group = N_LAYER;
+    for ( size_t layer = 0; layer < N_LAYER; ++layer )
+    {
+        _group_size[layer]  = N_SHEETS[layer] * N_XSTRIPS[layer];
+        _group_wraps[layer] = true;
+
+        for ( size_t sheet = 0; sheet < N_SHEETS[layer]; ++sheet, ++v_group )
+        {
+            _group_size[v_group] = N_VSTRIPS[layer];
+
+            size_t gid = _layer_offset[layer];
+            gid += sheet * ( N_XSTRIPS[layer] + N_VSTRIPS[layer] );
+            for ( size_t strip = 0; strip < N_XSTRIPS[layer]; ++strip, ++gid )
+            {
+                _cluster_group[gid] = layer;
+                _cluster_pos[gid]   = sheet * N_XSTRIPS[layer] + strip;
+            }
+            for ( size_t strip = 0; strip < N_VSTRIPS[layer]; ++strip, ++gid )
+            {
+                _cluster_group[gid] = v_group;
+                _cluster_pos[gid]   = strip;
+            }
+        }
+    }
+    return std::make_tuple( _cluster_group, _cluster_pos, _group_size, _group_wraps );
+}
+
+constexpr auto _init_cluster_groups_tuple = _init_cluster_groups();
+constexpr auto _cluster_group             = std::get<0>( _init_cluster_groups_tuple );
+constexpr auto _cluster_pos               = std::get<1>( _init_cluster_groups_tuple );
+constexpr auto _group_size                = std::get<2>( _init_cluster_groups_tuple );
+constexpr auto _group_wraps               = std::get<3>( _init_cluster_groups_tuple );
+
+/*
+ * Clustering of the strips of one event. Strips are sorted by group and position, and a
+ * new cluster starts when the group changes or the position jumps by more than
+ * `max_gap + 1`. In the X rings, the first and the last cluster are merged when they are
+ * close enough across the wrap. `position` receives the position of each strip in its
+ * group, increased by the group size for the strips after the wrap, so it grows along
+ * each cluster. Clusters are numbered in the gid order of their first strip, hits with
+ * invalid gid get cluster id -1.
+ *
+ * Returns the number of clusters.
+ */
+int64_t cluster_cgem_strips( const int64_t* gid, int64_t n, int64_t max_gap,
+                             int64_t* cluster_id, int64_t* position,
+                             std::vector<int64_t>& order, std::vector<int64_t>& first_hit,
+                             std::vector<int64_t>& ids ) {
+    order.clear();
+    for ( int64_t i = 0; i < n; ++i )
+    {
+        cluster_id[i] = -1;
+        if ( gid[i] >= 0 && gid[i] < static_cast<int64_t>( N_STRIPS ) )
+        {
+            order.push_back( i );
+            position[i] = _cluster_pos[gid[i]];
+        }
+    }
+    std::sort( order.begin(), order.end(), [&]( int64_t a, int64_t b ) {
+        return std::make_pair( _cluster_group[gid[a]], position[a] ) <
+               std::make_pair( _cluster_group[gid[b]], position[b] );
+    } );
+    if ( order.empty() ) return 0;
+
+    int64_t n_clusters = 0;
+    size_t group_begin = 0;
+    for ( size_t k = 0; k <= order.size(); ++k )
+    {
+        bool new_group = k == order.size() ||
+                         ( k > 0 && _cluster_group[gid[order[k]]] !=
+                                        _cluster_group[gid[order[k - 1]]] );
+
+        // merge the first cluster of a finished X ring into its last one across the wrap
+        if ( new_group )
+        {
+            auto group    = _cluster_group[gid[order[group_begin]]];
+            auto first    = order[group_begin];
+            auto last     = order[k - 1];
+            int64_t space = _group_size[group] - position[last] + position[first];
+            if ( _group_wraps[group] && cluster_id[first] != cluster_id[last] &&
+                 space <= max_gap + 1 )
+            {
+                int64_t merged = cluster_id[first];
+                for ( size_t j = group_begin; cluster_id[order[j]] == merged; ++j )
+                {
+                    cluster_id[order[j]] = cluster_id[last];
+                    position[order[j]] += _group_size[group];
+                }
+            }
+
+            if ( k == order.size() ) break;
+            group_begin = k;
+        }
+
+        int64_t step = k > 0 ? position[order[k]] - position[order[k - 1]] : 0;
+        if ( k > 0 && ( new_group || step > max_gap + 1 ) ) n_clusters++;
+        cluster_id[order[k]] = n_clusters;
+    }
+
+    // renumber the clusters by the gid of their first strip, skipping the merged ones
+    first_hit.assign( n_clusters + 1, -1 );
+    for ( auto i : order )
+    {
+        int64_t& f = first_hit[cluster_id[i]];
+        if ( f < 0 || position[i] < position[f] ) f = i;
+    }
+
+    ids.clear();
+    for ( int64_t c = 0; c <= n_clusters; ++c )
+        if ( first_hit[c] >= 0 ) ids.push_back( c );
+    std::sort( ids.begin(), ids.end(), [&]( int64_t a, int64_t b ) {
+        return gid[first_hit[a]] < gid[first_hit[b]];
+    } );
+
+    for ( size_t j = 0; j < ids.size(); ++j ) first_hit[ids[j]] = j; // now the new ids
+    for ( auto i : order ) cluster_id[i] = first_hit[cluster_id[i]];
+
+    return ids.size();
+}
+
+PyObject* _cgem_cluster_strips( PyObject* self, PyObject* args ) {
+    PyArrayObject *offsets = nullptr, *gid = nullptr, *charge = nullptr;
+    long long max_gap      = 0;
+
+    if ( !PyArg_ParseTuple( args, "O!O!O!L",         //
+                            &PyArray_Type, &offsets, //
+                            &PyArray_Type, &gid,     //
+                            &PyArray_Type, &charge,  //
+                            &max_gap ) )             //
+        return nullptr;
+
+    npy_intp n_hits = PyArray_SIZE( gid );
+    if ( PyArray_TYPE( gid ) != NPY_INT64 || PyArray_TYPE( charge ) != NPY_DOUBLE ||
+         PyArray_NDIM( gid ) != 1 || PyArray_NDIM( charge ) != 1 ||
+         !PyArray_IS_C_CONTIGUOUS( gid ) || !PyArray_IS_C_CONTIGUOUS( charge ) ||
+         PyArray_SIZE( charge ) != n_hits )
+    {
+        PyErr_SetString( PyExc_ValueError,
+                         "gid and charge must be contiguous 1D int64 and float64 arrays" );
+        return nullptr;
+    }
+
+    if ( max_gap < 0 )
+    {
+        PyErr_SetString( PyExc_ValueError, "max_gap must be non-negative" );
+        return nullptr;
+    }
+
+    if ( !check_offsets( offsets, n_hits ) ) return nullptr;
+
+    npy_intp n_events        = PyArray_SIZE( offsets ) - 1;
+    npy_intp offsets_dims[1] = { n_events + 1 };
+    PyObject* out_id         = PyArray_SimpleNew( 1, &n_hits, NPY_INT64 );
+    PyObject* out_offsets    = PyArray_ZEROS( 1, offsets_dims, NPY_INT64, 0 );
+    if ( !out_id || !out_offsets )
+    {
+        Py_XDECREF( out_id );
+        Py_XDECREF( out_offsets );
+        return nullptr;
+    }
+
+    auto poffsets     = static_cast<const int64_t*>( PyArray_DATA( offsets ) );
+    auto pgid         = static_cast<const int64_t*>( PyArray_DATA( gid ) );
+    auto pcharge      = static_cast<const double*>( PyArray_DATA( charge ) );
+    auto pid          = static_cast<int64_t*>( PyArray_DATA( (PyArrayObject*)out_id ) );
+    auto pout_offsets = static_cast<int64_t*>( PyArray_DATA( (PyArrayObject*)out_offsets ) );
+
+    // position of the strips along their cluster, see `cluster_cgem_strips`
+    std::vector<int64_t> position( n_hits );
+    auto ppos = position.data();
+
+    // first pass: cluster ids of hits and number of clusters of each event
+    auto run_cluster = [=]( int64_t start, int64_t stop ) {
+        std::vector<int64_t> order, first_hit, ids;
+        for ( int64_t i = start; i < stop; ++i )
+        {
+            int64_t begin       = poffsets[i];
+            pout_offsets[i + 1] = cluster_cgem_strips( pgid + begin, poffsets[i + 1] - begin,
+                                                       max_gap, pid + begin, ppos + begin,
+                                                       order, first_hit, ids );
+        }
+    };
+
+    Py_BEGIN_ALLOW_THREADS;
+    auto& pool = ThreadPool::instance();
+    if ( pool.should_split( n_events ) ) pool.parallel_for( n_events, run_cluster );
+    else run_cluster( 0, n_events );
+    for ( npy_intp i = 0; i < n_events; ++i ) pout_offsets[i + 1] += pout_offsets[i];
+    Py_END_ALLOW_THREADS;
+
+    npy_intp n_clusters  = pout_offsets[n_events];
+    PyObject* out_gid    = PyArray_ZEROS( 1, &n_clusters, NPY_INT64, 0 );
+    PyObject* out_center = PyArray_ZEROS( 1, &n_clusters, NPY_DOUBLE, 0 );
+    PyObject* out_charge = PyArray_ZEROS( 1, &n_clusters, NPY_DOUBLE, 0 );
+    PyObject* out_size   = PyArray_ZEROS( 1, &n_clusters, NPY_INT64, 0 );
+    if ( !out_gid || !out_center || !out_charge || !out_size )
+    {
+        for ( auto out : { out_id, out_offsets, out_gid, out_center, out_charge, out_size } )
+            Py_XDECREF( out );
+        return nullptr;
+    }
+
+    auto pcl_gid    = static_cast<int64_t*>( PyArray_DATA( (PyArrayObject*)out_gid ) );
+    auto pcl_center = static_cast<double*>( PyArray_DATA( (PyArrayObject*)out_center ) );
+    auto pcl_charge = static_cast<double*>( PyArray_DATA( (PyArrayObject*)out_charge ) );
+    auto pcl_size   = static_cast<int64_t*>( PyArray_DATA( (PyArrayObject*)out_size ) );
+
+    // second pass: first strip, charge sum and charge-weighted centroid (in units of
+    // strips) of clusters. Clusters without positive charge sum use the mean strip. The
+    // centroid is taken on the positions along the cluster, then counted from the sheet of
+    // the first strip, so it goes past the last strip of that sheet for clusters across a
+    // sheet boundary or phi = 0.
+    auto run_sum = [=]( int64_t start, int64_t stop ) {
+        std::vector<double> strip_sum;
+        std::vector<int64_t> first_pos;
+        for ( int64_t i = start; i < stop; ++i )
+        {
+            int64_t first = pout_offsets[i];
+            strip_sum.assign( pout_offsets[i + 1] - first, 0.0 );
+            first_pos.assign( pout_offsets[i + 1] - first, 0 );
+
+            for ( int64_t h = poffsets[i]; h < poffsets[i + 1]; ++h )
+            {
+                if ( pid[h] < 0 ) continue;
+                int64_t c = first + pid[h];
+                if ( pcl_size[c]++ == 0 || ppos[h] < first_pos[pid[h]] )
+                {
+                    pcl_gid[c]        = pgid[h];
+                    first_pos[pid[h]] = ppos[h];
+                }
+                pcl_charge[c] += pcharge[h];
+                pcl_center[c] += pcharge[h] * ppos[h];
+                strip_sum[pid[h]] += ppos[h];
+            }
+
+            for ( int64_t c = first; c < pout_offsets[i + 1]; ++c )
+            {
+                if ( pcl_charge[c] > 0 ) pcl_center[c] /= pcl_charge[c];
+                else pcl_center[c] = strip_sum[c - first] / pcl_size[c];
+                pcl_center[c] -= _cluster_pos[pcl_gid[c]] - _strip[pcl_gid[c]];
+            }
+        }
+    };
+
+    Py_BEGIN_ALLOW_THREADS;
+    auto& pool = ThreadPool::instance();
+    if ( pool.should_split( n_events ) ) pool.parallel_for( n_events, run_sum );
+    else run_sum( 0, n_events );
+    Py_END_ALLOW_THREADS;
+
+    return Py_BuildValue( "NNNNNN", out_id, out_offsets, out_gid, out_center, out_charge,
+                          out_size );
+}
+
+/*
+ * Intersections of the X and V clusters of one event in the same layer and sheet. Each
+ * sheet is unrolled to (s, z), with s = R * phi from the start of the sheet. X strip k
+ * is at s = (k + 0.5) * 2 pi R / (n_sheets * n_xstrips), V strip j is the line
+ * s = v_offset + (j + 0.5) * v_pitch + z * tan(stereo_angle). Intersections outside
+ * |z| <= half_length are dropped.
+ *
+ * When `x` is null, only the number of intersections is returned.
+ */
+int64_t cgem_xv_intersection( const int64_t* gid, const double* center, int64_t n,
+                              const double* radius, const double* tan_stereo,
+                              const double* v_pitch, const double* v_offset,
+                              const double* half_length, int64_t* x_cluster,
+                              int64_t* v_cluster, double* x, double* y, double* z ) {
+    int64_t n_points = 0;
+    for ( int64_t i = 0; i < n; ++i )
+    {
+        if ( _strip_type[gid[i]] != X_STRIP_TYPE ) continue;
+
+        auto layer  = _layer[gid[i]];
+        auto sheet  = _sheet[gid[i]];
+        double dphi = 2.0 * std::numbers::pi / ( N_SHEETS[layer] * N_XSTRIPS[layer] );
+        double phi  = ( sheet * N_XSTRIPS[layer] + center[i] + 0.5 ) * dphi;
+        double s_x  = radius[layer] * ( center[i] + 0.5 ) * dphi;
+
+        for ( int64_t j = 0; j < n; ++j )
+        {
+            if ( _strip_type[gid[j]] != V_STRIP_TYPE || _layer[gid[j]] != layer ||
+                 _sheet[gid[j]] != sheet )
+                continue;
+
+            double s_v = v_offset[layer] + ( center[j] + 0.5 ) * v_pitch[layer];
+            double z_j = ( s_x - s_v ) / tan_stereo[layer];
+            if ( !( std::abs( z_j ) <= half_length[layer] ) ) continue;
+
+            if ( x )
+            {
+                x_cluster[n_points] = i;
+                v_cluster[n_points] = j;
+                x[n_points]         = radius[layer] * std::cos( phi );
+                y[n_points]         = radius[layer] * std::sin( phi );
+                z[n_points]         = z_j;
+            }
+            n_points++;
+        }
+    }
+    return n_points;
+}
+
+PyObject* _cgem_xv_intersection( PyObject* self, PyObject* args ) {
+    PyArrayObject *offsets = nullptr, *gid = nullptr, *center = nullptr, *geometry = nullptr;
+
+    if ( !PyArg_ParseTuple( args, "O!O!O!O!",        //
+                            &PyArray_Type, &offsets, //
+                            &PyArray_Type, &gid,     //
+                            &PyArray_Type, &center,  //
+                            &PyArray_Type, &geometry //
+                            ) )                      //
+        return nullptr;
+
+    npy_intp n_clusters = PyArray_SIZE( gid );
+    if ( PyArray_TYPE( gid ) != NPY_INT64 || PyArray_TYPE( center ) != NPY_DOUBLE ||
+         PyArray_NDIM( gid ) != 1 || PyArray_NDIM( center ) != 1 ||
+         !PyArray_IS_C_CONTIGUOUS( gid ) || !PyArray_IS_C_CONTIGUOUS( center ) ||
+         PyArray_SIZE( center ) != n_clusters )
+    {
+        PyErr_SetString( PyExc_ValueError,
+                         "gid and center must be contiguous 1D int64 and float64 arrays" );
+        return nullptr;
+    }
+
+    if ( PyArray_TYPE( geometry ) != NPY_DOUBLE || PyArray_NDIM( geometry ) != 2 ||
+         PyArray_DIM( geometry, 0 ) != 5 || PyArray_DIM( geometry, 1 ) != N_LAYER ||
+         !PyArray_IS_C_CONTIGUOUS( geometry ) )
+    {
+        PyErr_SetString( PyExc_ValueError,
+                         "geometry must be a contiguous (5, 3) float64 array" );
+        return nullptr;
+    }
+
+    if ( !check_offsets( offsets, n_clusters ) ) return nullptr;
+
+    auto pgid = static_cast<const int64_t*>( PyArray_DATA( gid ) );
+    for ( npy_intp i = 0; i < n_clusters; ++i )
+    {
+        if ( pgid[i] < 0 || pgid[i] >= static_cast<int64_t>( N_STRIPS ) )
+        {
+            PyErr_SetString( PyExc_ValueError, "invalid CGEM gid of clusters" );
+            return nullptr;
+        }
+    }
+
+    npy_intp n_events        = PyArray_SIZE( offsets ) - 1;
+    npy_intp offsets_dims[1] = { n_events + 1 };
+    PyObject* out_offsets    = PyArray_ZEROS( 1, offsets_dims, NPY_INT64, 0 );
+    if ( !out_offsets ) return nullptr;
+
+    auto poffsets     = static_cast<const int64_t*>( PyArray_DATA( offsets ) );
+    auto pcenter      = static_cast<const double*>( PyArray_DATA( center ) );
+    auto pgeom        = static_cast<const double*>( PyArray_DATA( geometry ) );
+    auto pout_offsets = static_cast<int64_t*>( PyArray_DATA( (PyArrayObject*)out_offsets ) );
+
+    // radius, tan(stereo_angle), v_pitch, v_offset, half_length of each layer
+    const double* geom[5];
+    for ( size_t k = 0; k < 5; ++k ) geom[k] = pgeom + k * N_LAYER;
+
+    // first pass: number of intersections of each event, second pass: fill them
+    auto run_count = [=]( int64_t start, int64_t stop ) {
+        for ( int64_t i = start; i < stop; ++i )
+        {
+            int64_t begin       = poffsets[i];
+            pout_offsets[i + 1] = cgem_xv_intersection(
+                pgid + begin, pcenter + begin, poffsets[i + 1] - begin, geom[0], geom[1],
+                geom[2], geom[3], geom[4], nullptr, nullptr, nullptr, nullptr, nullptr );
+        }
+    };
+
+    Py_BEGIN_ALLOW_THREADS;
+    auto& pool = ThreadPool::instance();
+    if ( pool.should_split( n_events ) ) pool.parallel_for( n_events, run_count );
+    else run_count( 0, n_events );
+    for ( npy_intp i = 0; i < n_events; ++i ) pout_offsets[i + 1] += pout_offsets[i];
+    Py_END_ALLOW_THREADS;
+
+    npy_intp n_points = pout_offsets[n_events];
+    PyObject* out_xc  = PyArray_SimpleNew( 1, &n_points, NPY_INT64 );
+    PyObject* out_vc  = PyArray_SimpleNew( 1, &n_points, NPY_INT64 );
+    PyObject* out_x   = PyArray_SimpleNew( 1, &n_points, NPY_DOUBLE );
+    PyObject* out_y   = PyArray_SimpleNew( 1, &n_points, NPY_DOUBLE );
+    PyObject* out_z   = PyArray_SimpleNew( 1, &n_points, NPY_DOUBLE );
+    if ( !out_xc || !out_vc || !out_x || !out_y || !out_z )
+    {
+        for ( auto out : { out_offsets, out_xc, out_vc, out_x, out_y, out_z } )
+            Py_XDECREF( out );
+        return nullptr;
+    }
+
+    auto pxc = static_cast<int64_t*>( PyArray_DATA( (PyArrayObject*)out_xc ) );
+    auto pvc = static_cast<int64_t*>( PyArray_DATA( (PyArrayObject*)out_vc ) );
+    auto px  = static_cast<double*>( PyArray_DATA( (PyArrayObject*)out_x ) );
+    auto py  = static_cast<double*>( PyArray_DATA( (PyArrayObject*)out_y ) );
+    auto pz  = static_cast<double*>( PyArray_DATA( (PyArrayObject*)out_z ) );
+
+    auto run_fill = [=]( int64_t start, int64_t stop ) {
+        for ( int64_t i = start; i < stop; ++i )
+        {
+            int64_t begin = poffsets[i];
+            int64_t p     = pout_offsets[i];
+            cgem_xv_intersection( pgid + begin, pcenter + begin, poffsets[i + 1] - begin,
+                                  geom[0], geom[1], geom[2], geom[3], geom[4], pxc + p,
+                                  pvc + p, px + p, py + p, pz + p );
+        }
+    };
+
+    Py_BEGIN_ALLOW_THREADS;
+    auto& pool = ThreadPool::instance();
+    if ( pool.should_split( n_events ) ) pool.parallel_for( n_events, run_fill );
+    else run_fill( 0, n_events );
+    Py_END_ALLOW_THREADS;
+
+    return Py_BuildValue( "NNNNNN", out_offsets, out_xc, out_vc, out_x, out_y, out_z );
+}
+
 void declare_cgem( PyObject* d ) {
     if ( _import_array() < 0 ) return;
     if ( _import_umath() < 0 ) return;
@@ -108,6 +590,12 @@ void declare_cgem( PyObject* d ) {
         get_cgem_gid<int64_t>>  //
         ( d, "get_cgem_gid" );
 
+    decl_ufunc_11<                //
+        cgem_id_to_gid<uint32_t>, //
+        cgem_id_to_gid<uint64_t>, //
+        cgem_id_to_gid<int64_t>>  //
+        ( d, "cgem_id_to_gid" );
+
     decl_ufunc_11<                   //
         cgem_gid_to_layer<uint16_t>, //
         cgem_gid_to_layer<int16_t>,  //
@@ -161,4 +649,13 @@ void declare_cgem( PyObject* d ) {
         cgem_gid_to_is_vstrip<uint64_t>, //
         cgem_gid_to_is_vstrip<int64_t>>  //
         ( d, "cgem_gid_to_is_vstrip" );
+
+    decl_ufunc<1, 6,                     //
+               parse_cgem_gid<uint16_t>, //
+               parse_cgem_gid<int16_t>,  //
+               parse_cgem_gid<uint32_t>, //
+               parse_cgem_gid<int32_t>,  //
+               parse_cgem_gid<uint64_t>, //
+               parse_cgem_gid<int64_t>>  //
+        ( d, "parse_cgem_gid" );
 }
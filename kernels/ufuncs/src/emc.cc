@@ -1,3 +1,11 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <vector>
+
+#include "digi.hh"
+#include "gid.hh"
 #include "mod.hh"
 #include "ufunc.hh"
 
@@ -82,6 +90,66 @@ constexpr auto _part             = std::get<0>( _init_index_tuple );
 constexpr auto _theta            = std::get<1>( _init_index_tuple );
 constexpr auto _phi              = std::get<2>( _init_index_tuple );
 
+/*
+ * Neighbour table. In gid order, crystals form 56 consecutive theta rings (part 0 theta
+ * 0-5, barrel theta 0-43, part 2 theta 5-0), so the barrel/endcap seams are just adjacent
+ * rings with different numbers of phi. Two crystals are neighbours if they are in the
+ * same or adjacent rings and their phi ranges [phi, phi + 1) / n_phi overlap or touch,
+ * which includes the diagonal ones and wraps around in phi.
+ *
+ * The phi ranges come from the crystal indices only. The per-ring phi offsets of the real
+ * geometry are ignored, so a neighbour in an adjacent ring can be up to ~1.4 times further
+ * away than the closest crystal of that ring.
+ */
+constexpr size_t N_RINGS       = 56;
+constexpr size_t MAX_NEIGHBOUR = 8;
+
+consteval auto _init_neighbours() {
+    std::array<size_t, N_RINGS + 1> ring_start{};
+    size_t n_rings = 0;
+    for ( size_t gid = 0; gid < N_CRYSTALS; ++gid )
+    {
+        if ( gid == 0 || _part[gid] != _part[gid - 1] || _theta[gid] != _theta[gid - 1] )
+            ring_start[n_rings++] = gid;
+    }
+    ring_start[N_RINGS] = N_CRYSTALS;
+
+    std::array<std::array<uint16_t, MAX_NEIGHBOUR>, N_CRYSTALS> _neighbours{};
+    std::array<uint8_t, N_CRYSTALS> _n_neighbours{};
+
+    for ( size_t ring = 0; ring < N_RINGS; ++ring )
+    {
+        int64_t n_a = ring_start[ring + 1] - ring_start[ring];
+        for ( int64_t i = 0; i < n_a; ++i )
+        {
+            size_t gid   = ring_start[ring] + i;
+            size_t first = ring == 0 ? 0 : ring - 1;
+            size_t last  = std::min( ring + 1, N_RINGS - 1 );
+            for ( size_t other = first; other <= last; ++other )
+            {
+                int64_t n_b = ring_start[other + 1] - ring_start[other];
+
+                // j / n_b <= (i + 1) / n_a and i / n_a <= (j + 1) / n_b, with j unwrapped
+                for ( int64_t j = i * n_b / n_a - 1; j * n_a <= ( i + 1 ) * n_b; ++j )
+                {
+                    if ( i * n_b > ( j + 1 ) * n_a ) continue;
+                    size_t nb = ring_start[other] + ( j + n_b ) % n_b;
+                    if ( nb == gid ) continue;
+
+                    // exceeding `MAX_NEIGHBOUR` fails the compilation
+                    _neighbours[gid][_n_neighbours[gid]++] = static_cast<uint16_t>( nb );
+                }
+            }
+        }
+    }
+
+    return std::make_tuple( _neighbours, _n_neighbours );
+}
+
+constexpr auto _init_neighbours_tuple = _init_neighbours();
+constexpr auto _neighbours            = std::get<0>( _init_neighbours_tuple );
+constexpr auto _n_neighbours          = std::get<1>( _init_neighbours_tuple );
+
 /* Geometry arrays */
 std::array<double, N_CRYSTALS * 8> _points_x{};
 std::array<double, N_CRYSTALS * 8> _points_y{};
@@ -93,6 +161,46 @@ std::array<double, N_CRYSTALS> _front_center_x{};
 std::array<double, N_CRYSTALS> _front_center_y{};
 std::array<double, N_CRYSTALS> _front_center_z{};
 
+/* theta/phi grid over the crystal front centers, built in `_init_emc_geom` */
+constexpr int GRID_N_THETA   = 64;
+constexpr int GRID_N_PHI     = 64;
+constexpr double GRID_DTHETA = std::numbers::pi / GRID_N_THETA;
+constexpr double GRID_DPHI   = 2.0 * std::numbers::pi / GRID_N_PHI;
+
+std::array<uint32_t, GRID_N_THETA * GRID_N_PHI + 1> _grid_offsets{};
+std::array<uint16_t, N_CRYSTALS> _grid_gids{};
+
+inline void direction_to_grid( double x, double y, double z, double& theta, double& phi,
+                               int& i_theta, int& i_phi ) noexcept {
+    theta = std::atan2( std::hypot( x, y ), z );
+    phi   = std::atan2( y, x );
+    if ( phi < 0 ) phi += 2.0 * std::numbers::pi;
+
+    i_theta = std::min( static_cast<int>( theta / GRID_DTHETA ), GRID_N_THETA - 1 );
+    i_phi   = std::min( static_cast<int>( phi / GRID_DPHI ), GRID_N_PHI - 1 );
+}
+
+void _build_emc_grid() {
+    std::array<uint32_t, N_CRYSTALS> cell_of{};
+    std::array<uint32_t, GRID_N_THETA * GRID_N_PHI + 1> counts{};
+
+    for ( size_t gid = 0; gid < N_CRYSTALS; ++gid )
+    {
+        double theta, phi;
+        int i_theta, i_phi;
+        direction_to_grid( _front_center_x[gid], _front_center_y[gid], _front_center_z[gid],
+                           theta, phi, i_theta, i_phi );
+        cell_of[gid] = i_theta * GRID_N_PHI + i_phi;
+        counts[cell_of[gid] + 1]++;
+    }
+
+    for ( size_t i = 1; i < counts.size(); ++i ) counts[i] += counts[i - 1];
+    _grid_offsets = counts;
+
+    for ( size_t gid = 0; gid < N_CRYSTALS; ++gid )
+        _grid_gids[counts[cell_of[gid]]++] = static_cast<uint16_t>( gid );
+}
+
 PyObject* _init_emc_geom( PyObject* self, PyObject* args ) {
     PyArrayObject *points_x = nullptr, *points_y = nullptr, *points_z = nullptr;
     PyArrayObject *center_x = nullptr, *center_y = nullptr, *center_z = nullptr;
@@ -125,9 +233,563 @@ PyObject* _init_emc_geom( PyObject* self, PyObject* args ) {
     memcpy( _front_center_z.data(), PyArray_DATA( front_center_z ),
             _front_center_z.size() * sizeof( double ) );
 
+    _build_emc_grid();
     Py_RETURN_NONE;
 }
 
+/*
+ * Find the `k` crystals whose front centers are nearest to (x, y, z), sorted by
+ * distance. Grid cells are visited in rings around the cell of the point, until no
+ * crystal in the unvisited cells can be closer than the current k-th nearest one.
+ */
+void match_emc_crystals( double x, double y, double z, int64_t k, int64_t* gids,
+                         double* dists ) noexcept {
+    std::fill( gids, gids + k, -1 );
+    std::fill( dists, dists + k, std::numeric_limits<double>::quiet_NaN() );
+
+    double r = std::sqrt( x * x + y * y + z * z );
+    if ( !std::isfinite( r ) || r == 0 ) return;
+
+    double theta, phi;
+    int i_theta, i_phi;
+    direction_to_grid( x, y, z, theta, phi, i_theta, i_phi );
+
+    int64_t n_found = 0;
+    auto visit      = [&]( int row, int d_col ) {
+        int col  = ( ( i_phi + d_col ) % GRID_N_PHI + GRID_N_PHI ) % GRID_N_PHI;
+        int cell = row * GRID_N_PHI + col;
+        for ( uint32_t i = _grid_offsets[cell]; i < _grid_offsets[cell + 1]; ++i )
+        {
+            uint16_t gid = _grid_gids[i];
+            double dx    = _front_center_x[gid] - x;
+            double dy    = _front_center_y[gid] - y;
+            double dz    = _front_center_z[gid] - z;
+            double d     = std::sqrt( dx * dx + dy * dy + dz * dz );
+
+            // insertion into the sorted top-k list
+            int64_t pos;
+            if ( n_found < k ) pos = n_found++;
+            else if ( d < dists[k - 1] ) pos = k - 1;
+            else continue;
+
+            for ( ; pos > 0 && dists[pos - 1] > d; --pos )
+            {
+                dists[pos] = dists[pos - 1];
+                gids[pos]  = gids[pos - 1];
+            }
+            dists[pos] = d;
+            gids[pos]  = gid;
+        }
+    };
+
+    // columns are visited at offsets [-max_left, max_right] at most, so that each
+    // column is visited only once
+    constexpr int max_left  = GRID_N_PHI / 2;
+    constexpr int max_right = GRID_N_PHI - 1 - max_left;
+
+    for ( int m = 0;; ++m )
+    {
+        int left  = std::min( m, max_left );
+        int right = std::min( m, max_right );
+
+        for ( int d_row = -m; d_row <= m; ++d_row )
+        {
+            int row = i_theta + d_row;
+            if ( row < 0 || row >= GRID_N_THETA ) continue;
+
+            if ( std::abs( d_row ) == m )
+                for ( int d_col = -left; d_col <= right; ++d_col ) visit( row, d_col );
+            else
+            {
+                if ( m <= max_left ) visit( row, -m );
+                if ( m <= max_right ) visit( row, m );
+            }
+        }
+
+        // lower bound of the angle between the point and unvisited crystals
+        constexpr double inf = std::numeric_limits<double>::infinity();
+        double min_angle     = inf;
+        if ( i_theta - m > 0 ) min_angle = theta - ( i_theta - m ) * GRID_DTHETA;
+        if ( i_theta + m < GRID_N_THETA - 1 )
+            min_angle = std::min( min_angle, ( i_theta + m + 1 ) * GRID_DTHETA - theta );
+        if ( left < max_left || right < max_right )
+        {
+            double d_phi = std::min( phi - ( i_phi - left ) * GRID_DPHI,
+                                     ( i_phi + right + 1 ) * GRID_DPHI - phi );
+            d_phi        = std::min( d_phi, std::numbers::pi / 2 );
+
+            // angle between the point and the nearest unvisited meridian half-plane
+            double phi_angle = std::asin( std::sin( theta ) * std::sin( d_phi ) );
+            min_angle        = std::min( min_angle, phi_angle );
+        }
+
+        if ( min_angle == inf ) return;
+        if ( n_found < k ) continue;
+
+        double min_dist = min_angle < std::numbers::pi / 2 ? r * std::sin( min_angle ) : r;
+        if ( dists[k - 1] <= min_dist ) return;
+    }
+}
+
+PyObject* _emc_match_crystals( PyObject* self, PyObject* args ) {
+    PyArrayObject *x = nullptr, *y = nullptr, *z = nullptr;
+    Py_ssize_t k = 0;
+
+    if ( !PyArg_ParseTuple( args, "O!O!O!n",   //
+                            &PyArray_Type, &x, //
+                            &PyArray_Type, &y, //
+                            &PyArray_Type, &z, //
+                            &k ) )             //
+        return nullptr;
+
+    for ( auto arr : { x, y, z } )
+    {
+        if ( PyArray_TYPE( arr ) != NPY_DOUBLE || PyArray_NDIM( arr ) != 1 ||
+             !PyArray_IS_C_CONTIGUOUS( arr ) || PyArray_SIZE( arr ) != PyArray_SIZE( x ) )
+        {
+            PyErr_SetString( PyExc_ValueError,
+                             "x, y, z must be contiguous 1D float64 arrays of the same size" );
+            return nullptr;
+        }
+    }
+
+    if ( k < 1 || k > static_cast<Py_ssize_t>( N_CRYSTALS ) )
+    {
+        PyErr_SetString( PyExc_ValueError, "k must be in [1, 6240]" );
+        return nullptr;
+    }
+
+    npy_intp n         = PyArray_SIZE( x );
+    npy_intp dims[2]   = { n, k };
+    PyObject* out_gid  = PyArray_SimpleNew( 2, dims, NPY_INT64 );
+    PyObject* out_dist = PyArray_SimpleNew( 2, dims, NPY_DOUBLE );
+    if ( !out_gid || !out_dist )
+    {
+        Py_XDECREF( out_gid );
+        Py_XDECREF( out_dist );
+        return nullptr;
+    }
+
+    auto px    = static_cast<const double*>( PyArray_DATA( x ) );
+    auto py    = static_cast<const double*>( PyArray_DATA( y ) );
+    auto pz    = static_cast<const double*>( PyArray_DATA( z ) );
+    auto pgid  = static_cast<int64_t*>( PyArray_DATA( (PyArrayObject*)out_gid ) );
+    auto pdist = static_cast<double*>( PyArray_DATA( (PyArrayObject*)out_dist ) );
+
+    auto run = [=]( int64_t start, int64_t stop ) {
+        for ( int64_t i = start; i < stop; ++i )
+            match_emc_crystals( px[i], py[i], pz[i], k, pgid + i * k, pdist + i * k );
+    };
+
+    Py_BEGIN_ALLOW_THREADS;
+    auto& pool = ThreadPool::instance();
+    if ( pool.should_split( n ) ) pool.parallel_for( n, run );
+    else run( 0, n );
+    Py_END_ALLOW_THREADS;
+
+    return Py_BuildValue( "NN", out_gid, out_dist );
+}
+
+PyObject* _emc_neighbours( PyObject* self, PyObject* args ) {
+    npy_intp dims[2] = { N_CRYSTALS, MAX_NEIGHBOUR };
+    PyObject* out    = PyArray_SimpleNew( 2, dims, NPY_INT64 );
+    if ( !out ) return nullptr;
+
+    auto pout = static_cast<int64_t*>( PyArray_DATA( (PyArrayObject*)out ) );
+    for ( size_t gid = 0; gid < N_CRYSTALS; ++gid )
+        for ( size_t k = 0; k < MAX_NEIGHBOUR; ++k )
+            pout[gid * MAX_NEIGHBOUR + k] = k < _n_neighbours[gid] ? _neighbours[gid][k] : -1;
+
+    return out;
+}
+
+/*
+ * Connected-component clustering of the hits of one event. Hits on neighbouring
+ * crystals (or on the same crystal) get the same cluster id, clusters are numbered in
+ * the order of their first hit. Hits with invalid gid get cluster id -1.
+ *
+ * `head` must have `N_CRYSTALS` entries set to -1, and is restored on return.
+ * Returns the number of clusters.
+ */
+int64_t cluster_emc_hits( const int64_t* gid, int64_t n, int64_t* cluster_id,
+                          std::vector<int64_t>& head, std::vector<int64_t>& next,
+                          std::vector<int64_t>& stack ) {
+    auto is_valid = [&]( int64_t i ) {
+        return gid[i] >= 0 && gid[i] < static_cast<int64_t>( N_CRYSTALS );
+    };
+
+    // hits on each crystal as linked lists
+    next.assign( n, -1 );
+    for ( int64_t i = n - 1; i >= 0; --i )
+    {
+        cluster_id[i] = -1;
+        if ( !is_valid( i ) ) continue;
+        next[i]      = head[gid[i]];
+        head[gid[i]] = i;
+    }
+
+    int64_t n_clusters = 0;
+    auto push_crystal  = [&]( size_t crystal ) {
+        for ( int64_t h = head[crystal]; h >= 0; h = next[h] )
+        {
+            if ( cluster_id[h] >= 0 ) break; // all hits of a crystal are pushed together
+            cluster_id[h] = n_clusters;
+            stack.push_back( h );
+        }
+    };
+
+    for ( int64_t i = 0; i < n; ++i )
+    {
+        if ( cluster_id[i] >= 0 || !is_valid( i ) ) continue;
+
+        push_crystal( gid[i] );
+        while ( !stack.empty() )
+        {
+            size_t crystal = gid[stack.back()];
+            stack.pop_back();
+            for ( size_t k = 0; k < _n_neighbours[crystal]; ++k )
+                push_crystal( _neighbours[crystal][k] );
+        }
+        n_clusters++;
+    }
+
+    for ( int64_t i = 0; i < n; ++i )
+        if ( cluster_id[i] >= 0 ) head[gid[i]] = -1;
+
+    return n_clusters;
+}
+
+PyObject* _emc_cluster_hits( PyObject* self, PyObject* args ) {
+    PyArrayObject *offsets = nullptr, *gid = nullptr, *energy = nullptr;
+
+    if ( !PyArg_ParseTuple( args, "O!O!O!",          //
+                            &PyArray_Type, &offsets, //
+                            &PyArray_Type, &gid,     //
+                            &PyArray_Type, &energy   //
+                            ) )                      //
+        return nullptr;
+
+    if ( PyArray_TYPE( offsets ) != NPY_INT64 || PyArray_TYPE( gid ) != NPY_INT64 ||
+         PyArray_TYPE( energy ) != NPY_DOUBLE )
+    {
+        PyErr_SetString( PyExc_ValueError,
+                         "offsets, gid and energy must be int64, int64 and float64 arrays" );
+        return nullptr;
+    }
+
+    for ( auto arr : { offsets, gid, energy } )
+    {
+        if ( PyArray_NDIM( arr ) != 1 || !PyArray_IS_C_CONTIGUOUS( arr ) )
+        {
+            PyErr_SetString( PyExc_ValueError,
+                             "offsets, gid and energy must be contiguous 1D arrays" );
+            return nullptr;
+        }
+    }
+
+    npy_intp n_events = PyArray_SIZE( offsets ) - 1;
+    npy_intp n_hits   = PyArray_SIZE( gid );
+    auto poffsets     = static_cast<const int64_t*>( PyArray_DATA( offsets ) );
+    if ( n_events < 0 || PyArray_SIZE( energy ) != n_hits || poffsets[0] != 0 ||
+         poffsets[n_events] != n_hits )
+    {
+        PyErr_SetString( PyExc_ValueError, "offsets do not match gid and energy" );
+        return nullptr;
+    }
+
+    for ( npy_intp i = 0; i < n_events; ++i )
+    {
+        if ( poffsets[i] > poffsets[i + 1] )
+        {
+            PyErr_SetString( PyExc_ValueError, "offsets must be non-decreasing" );
+            return nullptr;
+        }
+    }
+
+    npy_intp offsets_dims[1] = { n_events + 1 };
+    PyObject* out_id         = PyArray_SimpleNew( 1, &n_hits, NPY_INT64 );
+    PyObject* out_offsets    = PyArray_ZEROS( 1, offsets_dims, NPY_INT64, 0 );
+    if ( !out_id || !out_offsets )
+    {
+        Py_XDECREF( out_id );
+        Py_XDECREF( out_offsets );
+        return nullptr;
+    }
+
+    auto pgid         = static_cast<const int64_t*>( PyArray_DATA( gid ) );
+    auto penergy      = static_cast<const double*>( PyArray_DATA( energy ) );
+    auto pid          = static_cast<int64_t*>( PyArray_DATA( (PyArrayObject*)out_id ) );
+    auto pout_offsets = static_cast<int64_t*>( PyArray_DATA( (PyArrayObject*)out_offsets ) );
+
+    // first pass: cluster ids of hits and number of clusters of each event
+    auto run_cluster = [=]( int64_t start, int64_t stop ) {
+        std::vector<int64_t> head( N_CRYSTALS, -1 ), next, stack;
+        for ( int64_t i = start; i < stop; ++i )
+        {
+            int64_t begin       = poffsets[i];
+            pout_offsets[i + 1] = cluster_emc_hits( pgid + begin, poffsets[i + 1] - begin,
+                                                    pid + begin, head, next, stack );
+        }
+    };
+
+    Py_BEGIN_ALLOW_THREADS;
+    auto& pool = ThreadPool::instance();
+    if ( pool.should_split( n_events ) ) pool.parallel_for( n_events, run_cluster );
+    else run_cluster( 0, n_events );
+    for ( npy_intp i = 0; i < n_events; ++i ) pout_offsets[i + 1] += pout_offsets[i];
+    Py_END_ALLOW_THREADS;
+
+    npy_intp n_clusters  = pout_offsets[n_events];
+    PyObject* out_seed   = PyArray_SimpleNew( 1, &n_clusters, NPY_INT64 );
+    PyObject* out_energy = PyArray_ZEROS( 1, &n_clusters, NPY_DOUBLE, 0 );
+    if ( !out_seed || !out_energy )
+    {
+        Py_DECREF( out_id );
+        Py_DECREF( out_offsets );
+        Py_XDECREF( out_seed );
+        Py_XDECREF( out_energy );
+        return nullptr;
+    }
+
+    auto pseed = static_cast<int64_t*>( PyArray_DATA( (PyArrayObject*)out_seed ) );
+    auto psum  = static_cast<double*>( PyArray_DATA( (PyArrayObject*)out_energy ) );
+    std::fill( pseed, pseed + n_clusters, -1 );
+    std::vector<double> seed_energy( n_clusters );
+    auto pmax = seed_energy.data();
+
+    // second pass: energy sums and seeds (gid of the most energetic hit) of clusters
+    auto run_sum = [=]( int64_t start, int64_t stop ) {
+        for ( int64_t i = start; i < stop; ++i )
+        {
+            for ( int64_t h = poffsets[i]; h < poffsets[i + 1]; ++h )
+            {
+                if ( pid[h] < 0 ) continue;
+                int64_t c = pout_offsets[i] + pid[h];
+                psum[c] += penergy[h];
+                if ( pseed[c] < 0 || penergy[h] > pmax[c] )
+                {
+                    pmax[c]  = penergy[h];
+                    pseed[c] = pgid[h];
+                }
+            }
+        }
+    };
+
+    Py_BEGIN_ALLOW_THREADS;
+    auto& pool = ThreadPool::instance();
+    if ( pool.should_split( n_events ) ) pool.parallel_for( n_events, run_sum );
+    else run_sum( 0, n_events );
+    Py_END_ALLOW_THREADS;
+
+    return Py_BuildValue( "NNNN", out_id, out_offsets, out_seed, out_energy );
+}
+
+/*
+ * Shower shape of one seed. `crystal_energy` holds the energy of each crystal in the
+ * event. Crystals within 1 (3x3) and 2 (5x5) steps in the neighbour table around the
+ * seed are collected, the centroid is the log-weighted mean of their front centers,
+ * with weights max(0, w0 + ln(E / E5x5)).
+ *
+ * The lateral moment is sum(E_i * r_i^2) / (sum(E_i * r_i^2) + (E_0 + E_1) * r0^2),
+ * where E_i are sorted in descending order, r_i is the distance to the centroid, the
+ * sum starts from i = 2, and r0 is the typical distance between crystals.
+ */
+constexpr double LAT_R0 = 5.2;
+
+struct EmcShowerShape {
+    double e1, e3x3, e5x5, e1_e9, x, y, z, lat_moment;
+};
+
+EmcShowerShape emc_shower_shape( int64_t seed, const std::vector<double>& crystal_energy,
+                                 double w0, std::vector<uint16_t>& crystals,
+                                 std::vector<int8_t>& depth ) {
+    constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+    EmcShowerShape res{ nan, nan, nan, nan, nan, nan, nan, nan };
+    if ( seed < 0 || seed >= static_cast<int64_t>( N_CRYSTALS ) ) return res;
+
+    // breadth-first search, crystals are sorted by depth
+    crystals.assign( 1, static_cast<uint16_t>( seed ) );
+    depth[seed] = 0;
+    size_t n_3x3 = 0;
+    for ( size_t i = 0; i < crystals.size(); ++i )
+    {
+        uint16_t crystal = crystals[i];
+        if ( depth[crystal] == 2 ) continue;
+        if ( depth[crystal] == 1 ) n_3x3 = i + 1;
+
+        for ( size_t k = 0; k < _n_neighbours[crystal]; ++k )
+        {
+            uint16_t nb = _neighbours[crystal][k];
+            if ( depth[nb] >= 0 ) continue;
+            depth[nb] = depth[crystal] + 1;
+            crystals.push_back( nb );
+        }
+    }
+    n_3x3 = std::max<size_t>( n_3x3, 1 );
+    for ( auto crystal : crystals ) depth[crystal] = -1;
+
+    res.e1   = crystal_energy[seed];
+    res.e3x3 = 0;
+    res.e5x5 = 0;
+    for ( size_t i = 0; i < crystals.size(); ++i )
+    {
+        if ( i < n_3x3 ) res.e3x3 += crystal_energy[crystals[i]];
+        res.e5x5 += crystal_energy[crystals[i]];
+    }
+    res.e1_e9 = res.e1 / res.e3x3;
+
+    // log-weighted centroid
+    double sum_w = 0, sum_x = 0, sum_y = 0, sum_z = 0;
+    for ( auto crystal : crystals )
+    {
+        double e = crystal_energy[crystal];
+        if ( !( e > 0 ) ) continue;
+
+        double w = std::max( 0.0, w0 + std::log( e / res.e5x5 ) );
+        sum_w += w;
+        sum_x += w * _front_center_x[crystal];
+        sum_y += w * _front_center_y[crystal];
+        sum_z += w * _front_center_z[crystal];
+    }
+    if ( !( sum_w > 0 ) ) return res;
+
+    res.x = sum_x / sum_w;
+    res.y = sum_y / sum_w;
+    res.z = sum_z / sum_w;
+
+    // lateral moment
+    std::sort( crystals.begin(), crystals.end(), [&]( uint16_t a, uint16_t b ) {
+        return crystal_energy[a] > crystal_energy[b];
+    } );
+
+    double sum_er2 = 0, e01 = 0;
+    for ( size_t i = 0; i < crystals.size(); ++i )
+    {
+        double e = crystal_energy[crystals[i]];
+        if ( i < 2 )
+        {
+            e01 += e;
+            continue;
+        }
+
+        double dx = _front_center_x[crystals[i]] - res.x;
+        double dy = _front_center_y[crystals[i]] - res.y;
+        double dz = _front_center_z[crystals[i]] - res.z;
+        sum_er2 += e * ( dx * dx + dy * dy + dz * dz );
+    }
+    res.lat_moment = sum_er2 / ( sum_er2 + e01 * LAT_R0 * LAT_R0 );
+
+    return res;
+}
+
+PyObject* _emc_shower_shape( PyObject* self, PyObject* args ) {
+    PyArrayObject *hit_offsets = nullptr, *gid = nullptr, *energy = nullptr;
+    PyArrayObject *seed_offsets = nullptr, *seed = nullptr;
+    double w0 = 0;
+
+    if ( !PyArg_ParseTuple( args, "O!O!O!O!O!d",          //
+                            &PyArray_Type, &hit_offsets,  //
+                            &PyArray_Type, &gid,          //
+                            &PyArray_Type, &energy,       //
+                            &PyArray_Type, &seed_offsets, //
+                            &PyArray_Type, &seed,         //
+                            &w0 ) )                       //
+        return nullptr;
+
+    for ( auto arr : { hit_offsets, gid, energy, seed_offsets, seed } )
+    {
+        int type = arr == energy ? NPY_DOUBLE : NPY_INT64;
+        if ( PyArray_TYPE( arr ) != type || PyArray_NDIM( arr ) != 1 ||
+             !PyArray_IS_C_CONTIGUOUS( arr ) )
+        {
+            PyErr_SetString( PyExc_ValueError,
+                             "energy must be a contiguous 1D float64 array, and the others "
+                             "contiguous 1D int64 arrays" );
+            return nullptr;
+        }
+    }
+
+    npy_intp n_events  = PyArray_SIZE( hit_offsets ) - 1;
+    npy_intp n_hits    = PyArray_SIZE( gid );
+    npy_intp n_seeds   = PyArray_SIZE( seed );
+    auto phit_offsets  = static_cast<const int64_t*>( PyArray_DATA( hit_offsets ) );
+    auto pseed_offsets = static_cast<const int64_t*>( PyArray_DATA( seed_offsets ) );
+    if ( n_events < 0 || PyArray_SIZE( seed_offsets ) != n_events + 1 ||
+         PyArray_SIZE( energy ) != n_hits || phit_offsets[0] != 0 ||
+         phit_offsets[n_events] != n_hits || pseed_offsets[0] != 0 ||
+         pseed_offsets[n_events] != n_seeds )
+    {
+        PyErr_SetString( PyExc_ValueError, "offsets do not match hits and seeds" );
+        return nullptr;
+    }
+
+    for ( npy_intp i = 0; i < n_events; ++i )
+    {
+        if ( phit_offsets[i] > phit_offsets[i + 1] || pseed_offsets[i] > pseed_offsets[i + 1] )
+        {
+            PyErr_SetString( PyExc_ValueError, "offsets must be non-decreasing" );
+            return nullptr;
+        }
+    }
+
+    constexpr int n_out = 8;
+    PyObject* outs[n_out]{};
+    double* pouts[n_out]{};
+    for ( int k = 0; k < n_out; ++k )
+    {
+        outs[k] = PyArray_SimpleNew( 1, &n_seeds, NPY_DOUBLE );
+        if ( !outs[k] )
+        {
+            for ( int j = 0; j < k; ++j ) Py_DECREF( outs[j] );
+            return nullptr;
+        }
+        pouts[k] = static_cast<double*>( PyArray_DATA( (PyArrayObject*)outs[k] ) );
+    }
+
+    auto pgid    = static_cast<const int64_t*>( PyArray_DATA( gid ) );
+    auto penergy = static_cast<const double*>( PyArray_DATA( energy ) );
+    auto pseed   = static_cast<const int64_t*>( PyArray_DATA( seed ) );
+
+    auto run = [&]( int64_t start, int64_t stop ) {
+        std::vector<double> crystal_energy( N_CRYSTALS, 0.0 );
+        std::vector<int8_t> depth( N_CRYSTALS, -1 );
+        std::vector<uint16_t> crystals;
+
+        for ( int64_t i = start; i < stop; ++i )
+        {
+            for ( int64_t h = phit_offsets[i]; h < phit_offsets[i + 1]; ++h )
+                if ( pgid[h] >= 0 && pgid[h] < static_cast<int64_t>( N_CRYSTALS ) )
+                    crystal_energy[pgid[h]] += penergy[h];
+
+            for ( int64_t s = pseed_offsets[i]; s < pseed_offsets[i + 1]; ++s )
+            {
+                auto res = emc_shower_shape( pseed[s], crystal_energy, w0, crystals, depth );
+                pouts[0][s] = res.e1;
+                pouts[1][s] = res.e3x3;
+                pouts[2][s] = res.e5x5;
+                pouts[3][s] = res.e1_e9;
+                pouts[4][s] = res.x;
+                pouts[5][s] = res.y;
+                pouts[6][s] = res.z;
+                pouts[7][s] = res.lat_moment;
+            }
+
+            for ( int64_t h = phit_offsets[i]; h < phit_offsets[i + 1]; ++h )
+                if ( pgid[h] >= 0 && pgid[h] < static_cast<int64_t>( N_CRYSTALS ) )
+                    crystal_energy[pgid[h]] = 0.0;
+        }
+    };
+
+    Py_BEGIN_ALLOW_THREADS;
+    auto& pool = ThreadPool::instance();
+    if ( pool.should_split( n_events ) ) pool.parallel_for( n_events, run );
+    else run( 0, n_events );
+    Py_END_ALLOW_THREADS;
+
+    return Py_BuildValue( "NNNNNNNN", outs[0], outs[1], outs[2], outs[3], outs[4], outs[5],
+                          outs[6], outs[7] );
+}
+
 template <typename T>
 inline void get_emc_gid( T* part, T* theta, T* phi, T* out ) noexcept {
     if ( *part == 0 )
@@ -171,6 +833,35 @@ inline void get_emc_gid( T* part, T* theta, T* phi, T* out ) noexcept {
     }
 }
 
+// digi ID -> gid: one row per (part, theta), phi is the local index
+constexpr DigiLayout EMC_DIGI_LAYOUT = {
+    DIGI_EMC_FLAG, DIGI_EMC_MODULE_MASK | DIGI_EMC_THETA_MASK, DIGI_EMC_THETA_OFFSET,
+    DIGI_EMC_PHI_MASK, DIGI_EMC_PHI_OFFSET };
+
+constexpr auto _emc_digi_id = []( size_t gid ) -> uint32_t {
+    return ( _part[gid] << DIGI_EMC_MODULE_OFFSET ) |
+           ( _theta[gid] << DIGI_EMC_THETA_OFFSET ) | ( _phi[gid] << DIGI_EMC_PHI_OFFSET );
+};
+
+consteval auto _init_emc_digi_rows() {
+    DigiRows<EMC_DIGI_LAYOUT> rows{};
+    for ( size_t gid = 0; gid < N_CRYSTALS; ++gid )
+        add_digi_row<EMC_DIGI_LAYOUT>( rows, _emc_digi_id( gid ), gid );
+    return rows;
+}
+
+constexpr auto _emc_digi_rows = _init_emc_digi_rows();
+static_assert( check_digi_rows<EMC_DIGI_LAYOUT>( _emc_digi_rows, N_CRYSTALS, _emc_digi_id ) );
+
+template <typename T>
+inline void emc_id_to_gid( T* emc_id, int64_t* gid ) noexcept {
+    *gid = digi_row_gid<EMC_DIGI_LAYOUT>( _emc_digi_rows, *emc_id );
+}
+
+int64_t emc_digi_gid( uint64_t digi_id ) noexcept {
+    return digi_row_gid<EMC_DIGI_LAYOUT>( _emc_digi_rows, digi_id );
+}
+
 template <typename T>
 inline void emc_gid_to_part( T* gid, T* part ) noexcept {
     *part = _part[*gid];
@@ -231,6 +922,25 @@ inline void emc_gid_to_point_z( T* gid, T* point, double* out ) noexcept {
     *out = _points_z[*gid * 8 + *point];
 }
 
+template <typename T>
+inline void parse_emc_gid( T* gid, T* part, T* theta, T* phi ) noexcept {
+    *part  = _part[*gid];
+    *theta = _theta[*gid];
+    *phi   = _phi[*gid];
+}
+
+template <typename T>
+inline void emc_gid_to_geometry( T* gid, double* front_center_x, double* front_center_y,
+                                 double* front_center_z, double* center_x, double* center_y,
+                                 double* center_z ) noexcept {
+    *front_center_x = _front_center_x[*gid];
+    *front_center_y = _front_center_y[*gid];
+    *front_center_z = _front_center_z[*gid];
+    *center_x       = _center_x[*gid];
+    *center_y       = _center_y[*gid];
+    *center_z       = _center_z[*gid];
+}
+
 constexpr double MEASURE_EMAX[4] = { 0.078, 0.625, 2.500, 2.500 };
 
 template <typename T>
@@ -251,6 +961,12 @@ void declare_emc( PyObject* d ) {
         get_emc_gid<int64_t>>  //
         ( d, "get_emc_gid" );
 
+    decl_ufunc_11<               //
+        emc_id_to_gid<uint32_t>, //
+        emc_id_to_gid<uint64_t>, //
+        emc_id_to_gid<int64_t>>  //
+        ( d, "emc_id_to_gid" );
+
     decl_ufunc_11<                 //
         emc_gid_to_part<uint16_t>, //
         emc_gid_to_part<int16_t>,  //
@@ -367,4 +1083,20 @@ void declare_emc( PyObject* d ) {
         emc_adc_to_charge<uint64_t>, //
         emc_adc_to_charge<int64_t>>  //
         ( d, "emc_adc_to_charge" );
+
+    decl_ufunc<1, 3,                    //
+               parse_emc_gid<uint16_t>, //
+               parse_emc_gid<int16_t>,  //
+               parse_emc_gid<uint32_t>, //
+               parse_emc_gid<int32_t>,  //
+               parse_emc_gid<uint64_t>, //
+               parse_emc_gid<int64_t>>( d, "parse_emc_gid" );
+
+    decl_ufunc<1, 6,                          //
+               emc_gid_to_geometry<uint16_t>, //
+               emc_gid_to_geometry<int16_t>,  //
+               emc_gid_to_geometry<uint32_t>, //
+               emc_gid_to_geometry<int32_t>,  //
+               emc_gid_to_geometry<uint64_t>, //
+               emc_gid_to_geometry<int64_t>>( d, "emc_gid_to_geometry" );
 }
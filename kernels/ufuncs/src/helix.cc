@@ -1,17 +1,11 @@
 #include <cmath>
+#include <limits>
 #include <numbers>
 
+#include "helix.hh"
 #include "mod.hh"
 #include "ufunc.hh"
 
-// ---------------------------------------------------------------------------
-// Constant: 1000 / 2.99792458  (for kappa -> radius conversion)
-// ---------------------------------------------------------------------------
-static constexpr double kKappaToRadiusFactor = 1000.0 / 2.99792458;
-
-constexpr double TWO_PI  = 2.0 * std::numbers::pi_v<double>;
-constexpr double HALF_PI = std::numbers::pi_v<double> / 2.0;
-
 template <typename T>
 inline void dr_phi0_to_x( T* dr, T* phi0, T* x ) noexcept {
     *x = *dr * std::cos( *phi0 );
@@ -55,6 +49,254 @@ inline void _fix_dr_sign( T* dr, T* phi0, T* dist_phi, T* result ) noexcept {
     else *result = *dr;
 }
 
+// ---------------------------------------------------------------------------
+// Momentum, position and charge of a helix in a single pass. `sin` and `cos` of the
+// same `phi0` are merged into one `sincos` call by the compiler. The momentum and
+// position halves are also registered alone, for callers that only need one of them.
+// ---------------------------------------------------------------------------
+template <typename T>
+inline void _helix_momentum( T* kappa, T* phi0, T* tanl, T* pt, T* phi, T* pz ) noexcept {
+    *pt = T( 1.0 ) / std::abs( *kappa );
+    phi0_to_phi( phi0, phi );
+    *pz = *pt * *tanl;
+}
+
+template <typename T>
+inline void _helix_position( T* dr, T* phi0, T* dz, T* x, T* y, T* z ) noexcept {
+    T s = std::sin( *phi0 );
+    T c = std::cos( *phi0 );
+
+    *x = *dr * c;
+    *y = *dr * s;
+    *z = *dz;
+}
+
+template <typename T>
+inline void helix_kinematics( T* dr, T* phi0, T* kappa, T* dz, T* tanl, T* pt, T* phi, T* pz,
+                              T* x, T* y, T* z, int64_t* charge ) noexcept {
+    _helix_momentum( kappa, phi0, tanl, pt, phi, pz );
+    _helix_position( dr, phi0, dz, x, y, z );
+    kappa_to_charge( kappa, charge );
+}
+
+// ---------------------------------------------------------------------------
+// Pivot transformation, based on the BOSS `Helix::pivot` method
+// ---------------------------------------------------------------------------
+struct PivotShift {
+    double new_dr;
+    double new_phi0;
+    double new_dz;
+    double dphi;
+};
+
+inline PivotShift shift_pivot( double r, double dr, double phi0, double dz, double tanl,
+                               double old_px, double old_py, double old_pz, double new_px,
+                               double new_py, double new_pz ) noexcept {
+    // vector from the new pivot to the circle center
+    double rdr = r + dr;
+    double dx  = old_px + rdr * std::cos( phi0 ) - new_px;
+    double dy  = old_py + rdr * std::sin( phi0 ) - new_py;
+
+    PivotShift res;
+    res.new_dr   = std::hypot( dx, dy ) - r;
+    res.new_phi0 = std::atan2( dy, dx );
+    if ( res.new_phi0 < 0.0 ) res.new_phi0 += TWO_PI;
+
+    // rotation angle wrapped into (-pi, pi]
+    res.dphi = std::fmod( res.new_phi0 - phi0, TWO_PI );
+    if ( res.dphi > std::numbers::pi ) res.dphi -= TWO_PI;
+    else if ( res.dphi <= -std::numbers::pi ) res.dphi += TWO_PI;
+
+    res.new_dz = old_pz + dz - r * tanl * res.dphi - new_pz;
+    return res;
+}
+
+inline void _helix_change_pivot( double* r, double* dr, double* phi0, double* dz,
+                                 double* tanl, double* old_px, double* old_py, double* old_pz,
+                                 double* new_px, double* new_py, double* new_pz,
+                                 double* out_dr, double* out_phi0, double* out_dz ) noexcept {
+    auto res  = shift_pivot( *r, *dr, *phi0, *dz, *tanl, *old_px, *old_py, *old_pz, *new_px,
+                             *new_py, *new_pz );
+    *out_dr   = res.new_dr;
+    *out_phi0 = res.new_phi0;
+    *out_dz   = res.new_dz;
+}
+
+// gufunc loop of `_helix_change_pivot_error`, signature
+// (),(),(),(),(),(),(),(),(),(),(),(),(5,5)->(),(),(),(5,5)
+constexpr int PIVOT_NIN  = 13;
+constexpr int PIVOT_NOUT = 4;
+
+void _helix_change_pivot_error_loop( char** args, const npy_intp* dimensions,
+                                     const npy_intp* steps, void* data ) {
+    constexpr int NARGS = PIVOT_NIN + PIVOT_NOUT;
+
+    // core strides of the input and output error matrices
+    const npy_intp in_si  = steps[NARGS + 0];
+    const npy_intp in_sj  = steps[NARGS + 1];
+    const npy_intp out_si = steps[NARGS + 2];
+    const npy_intp out_sj = steps[NARGS + 3];
+
+    char* ptrs[NARGS];
+    for ( int i = 0; i < NARGS; ++i ) ptrs[i] = args[i];
+
+    for ( npy_intp n = 0; n < dimensions[0]; ++n )
+    {
+        double p[12];
+        for ( int i = 0; i < 12; ++i ) p[i] = *reinterpret_cast<double*>( ptrs[i] );
+        const double r = p[0], dr = p[1], kappa = p[4], tanl = p[5];
+
+        auto res =
+            shift_pivot( r, dr, p[2], p[3], tanl, p[6], p[7], p[8], p[9], p[10], p[11] );
+        *reinterpret_cast<double*>( ptrs[PIVOT_NIN + 0] ) = res.new_dr;
+        *reinterpret_cast<double*>( ptrs[PIVOT_NIN + 1] ) = res.new_phi0;
+        *reinterpret_cast<double*>( ptrs[PIVOT_NIN + 2] ) = res.new_dz;
+
+        // Jacobian d(new)/d(old), only non-zero elements are used below
+        const double cos_dphi = std::cos( res.dphi );
+        const double sin_dphi = std::sin( res.dphi );
+        const double rdr      = r + dr;
+        const double rdrpr    = 1.0 / ( r + res.new_dr );
+        const double r_kappa  = r / kappa;
+
+        double J[5][5] = {};
+
+        J[0][0] = cos_dphi;
+        J[0][1] = rdr * sin_dphi;
+        J[0][2] = r_kappa * ( 1.0 - cos_dphi );
+        J[1][0] = -rdrpr * sin_dphi;
+        J[1][1] = rdr * rdrpr * cos_dphi;
+        J[1][2] = r_kappa * rdrpr * sin_dphi;
+        J[2][2] = 1.0;
+        J[3][0] = r * rdrpr * tanl * sin_dphi;
+        J[3][1] = r * tanl * ( 1.0 - rdr * rdrpr * cos_dphi );
+        J[3][2] = r_kappa * tanl * ( res.dphi - r * rdrpr * sin_dphi );
+        J[3][3] = 1.0;
+        J[3][4] = -r * res.dphi;
+        J[4][4] = 1.0;
+
+        // JC = J * C
+        const char* c_ptr = ptrs[PIVOT_NIN - 1];
+        double JC[5][5]   = {};
+        for ( int k = 0; k < 5; ++k )
+        {
+            for ( int j = 0; j < 5; ++j )
+            {
+                double c_kj =
+                    *reinterpret_cast<const double*>( c_ptr + k * in_si + j * in_sj );
+                for ( int i = 0; i < 5; ++i ) JC[i][j] += J[i][k] * c_kj;
+            }
+        }
+
+        // out = JC * J^T
+        char* out_ptr = ptrs[NARGS - 1];
+        for ( int i = 0; i < 5; ++i )
+        {
+            for ( int j = 0; j < 5; ++j )
+            {
+                double v = 0.0;
+                for ( int k = 0; k < 5; ++k ) v += JC[i][k] * J[j][k];
+                *reinterpret_cast<double*>( out_ptr + i * out_si + j * out_sj ) = v;
+            }
+        }
+
+        for ( int i = 0; i < NARGS; ++i ) ptrs[i] += steps[i];
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Helix extrapolation. Points on the helix are parametrised by the turning angle `phi`
+// as in the BOSS `Helix::x(phi)` method, with the signed radius `r = alpha / kappa`.
+// The track moves forward when `r * phi <= 0`.
+// ---------------------------------------------------------------------------
+template <typename T>
+inline void helix_point_at( T phi, T r, T dr, T phi0, T kappa, T dz, T tanl, T pivot_x,
+                            T pivot_y, T pivot_z, T* x, T* y, T* z, T* path_length, T* px,
+                            T* py, T* pz, bool* reached ) noexcept {
+    T s0 = std::sin( phi0 );
+    T c0 = std::cos( phi0 );
+    T s1 = std::sin( phi0 + phi );
+    T c1 = std::cos( phi0 + phi );
+    T pt = T( 1.0 ) / std::abs( kappa );
+
+    *x           = pivot_x + dr * c0 + r * ( c0 - c1 );
+    *y           = pivot_y + dr * s0 + r * ( s0 - s1 );
+    *z           = pivot_z + dz - r * tanl * phi;
+    *path_length = -r * phi * std::sqrt( T( 1.0 ) + tanl * tanl );
+    *px          = -pt * s1;
+    *py          = pt * c1;
+    *pz          = pt * tanl;
+    *reached     = true;
+}
+
+template <typename T>
+inline void helix_not_reached( T* x, T* y, T* z, T* path_length, T* px, T* py, T* pz,
+                               bool* reached ) noexcept {
+    constexpr T nan = std::numeric_limits<T>::quiet_NaN();
+    *x = *y = *z = *path_length = *px = *py = *pz = nan;
+    *reached                                      = false;
+}
+
+// Intersection with the cylinder `x^2 + y^2 = radius^2`, the first one along the
+// flight direction within one turn.
+template <typename T>
+inline void helix_to_cylinder( T* dr, T* phi0, T* kappa, T* dz, T* tanl, T* pivot_x,
+                               T* pivot_y, T* pivot_z, T* radius, T* x, T* y, T* z,
+                               T* path_length, T* px, T* py, T* pz, bool* reached ) noexcept {
+    T r  = *kappa == 0 ? T( 0 ) : T( kKappaToRadiusFactor ) / *kappa;
+    T cx = *pivot_x + ( *dr + r ) * std::cos( *phi0 );
+    T cy = *pivot_y + ( *dr + r ) * std::sin( *phi0 );
+    T d  = std::hypot( cx, cy );
+
+    // |center - r * (cos(phi0 + phi), sin(phi0 + phi))| = radius
+    T cos_da = r * d == 0 ? T( 2 ) : ( d * d + r * r - *radius * *radius ) / ( 2 * r * d );
+    if ( !( std::abs( cos_da ) <= T( 1.0 ) ) )
+    {
+        helix_not_reached( x, y, z, path_length, px, py, pz, reached );
+        return;
+    }
+
+    T alpha = std::atan2( cy, cx ) - *phi0;
+    T da    = std::acos( cos_da );
+
+    T phi = std::numeric_limits<T>::infinity();
+    for ( T cand : { alpha + da, alpha - da } )
+    {
+        // move the candidate to the forward half of (-2pi, 2pi)
+        cand = std::fmod( cand, T( TWO_PI ) );
+        if ( r > 0 && cand > 0 ) cand -= T( TWO_PI );
+        else if ( r < 0 && cand < 0 ) cand += T( TWO_PI );
+
+        if ( std::abs( cand ) < std::abs( phi ) ) phi = cand;
+    }
+
+    helix_point_at( phi, r, *dr, *phi0, *kappa, *dz, *tanl, *pivot_x, *pivot_y, *pivot_z, x,
+                    y, z, path_length, px, py, pz, reached );
+}
+
+// Intersection with the plane `z = z_plane`.
+template <typename T>
+inline void helix_to_z_plane( T* dr, T* phi0, T* kappa, T* dz, T* tanl, T* pivot_x,
+                              T* pivot_y, T* pivot_z, T* z_plane, T* x, T* y, T* z,
+                              T* path_length, T* px, T* py, T* pz, bool* reached ) noexcept {
+    if ( *kappa == 0 || *tanl == 0 )
+    {
+        helix_not_reached( x, y, z, path_length, px, py, pz, reached );
+        return;
+    }
+
+    T r   = T( kKappaToRadiusFactor ) / *kappa;
+    T phi = ( *pivot_z + *dz - *z_plane ) / ( r * *tanl );
+    if ( r * phi > 0 )
+    {
+        helix_not_reached( x, y, z, path_length, px, py, pz, reached );
+        return;
+    }
+
+    helix_point_at( phi, r, *dr, *phi0, *kappa, *dz, *tanl, *pivot_x, *pivot_y, *pivot_z, x,
+                    y, z, path_length, px, py, pz, reached );
+}
+
 void declare_helix( PyObject* d ) {
     if ( _import_array() < 0 ) return;
     if ( _import_umath() < 0 ) return;
@@ -93,4 +335,45 @@ void declare_helix( PyObject* d ) {
         _fix_dr_sign<double>, //
         _fix_dr_sign<float>>  //
         ( d, "_fix_dr_sign" );
+
+    decl_ufunc<5, 7,                     //
+               helix_kinematics<double>, //
+               helix_kinematics<float>>  //
+        ( d, "helix_kinematics" );
+
+    decl_ufunc<3, 3,                    //
+               _helix_momentum<double>, //
+               _helix_momentum<float>>  //
+        ( d, "_helix_momentum" );
+
+    decl_ufunc<3, 3,                    //
+               _helix_position<double>, //
+               _helix_position<float>>  //
+        ( d, "_helix_position" );
+
+    decl_ufunc<9, 8,                      //
+               helix_to_cylinder<double>, //
+               helix_to_cylinder<float>>  //
+        ( d, "helix_to_cylinder" );
+
+    decl_ufunc<9, 8,                     //
+               helix_to_z_plane<double>, //
+               helix_to_z_plane<float>>  //
+        ( d, "helix_to_z_plane" );
+
+    decl_ufunc<11, 3, _helix_change_pivot>( d, "_helix_change_pivot" );
+
+    {
+        static PyUFuncGenericFunction funcs[] = { _helix_change_pivot_error_loop };
+        static char types[PIVOT_NIN + PIVOT_NOUT];
+        for ( auto& t : types ) t = NPY_DOUBLE;
+
+        auto obj = PyUFunc_FromFuncAndDataAndSignature(
+            funcs, NULL, types, 1, PIVOT_NIN, PIVOT_NOUT, PyUFunc_None,
+            "_helix_change_pivot_error", "", 0,
+            "(),(),(),(),(),(),(),(),(),(),(),(),(5,5)->(),(),(),(5,5)" );
+        if ( obj == NULL ) return;
+        PyDict_SetItemString( d, "_helix_change_pivot_error", obj );
+        Py_DECREF( obj );
+    }
 }
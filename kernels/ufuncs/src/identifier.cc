@@ -1,64 +1,8 @@
+#include "digi.hh"
+#include "gid.hh"
 #include "mod.hh"
 #include "ufunc.hh"
 
-constexpr uint32_t DIGI_MDC_FLAG    = 0x10;
-constexpr uint32_t DIGI_TOF_FLAG    = 0x20;
-constexpr uint32_t DIGI_EMC_FLAG    = 0x30;
-constexpr uint32_t DIGI_MUC_FLAG    = 0x40;
-constexpr uint32_t DIGI_CGEM_FLAG   = 0x60;
-constexpr uint32_t DIGI_FLAG_OFFSET = 24;
-constexpr uint32_t DIGI_FLAG_MASK   = 0xFF000000;
-
-constexpr uint32_t DIGI_MDC_WIRETYPE_OFFSET = 15;
-constexpr uint32_t DIGI_MDC_WIRETYPE_MASK   = 0x00008000;
-constexpr uint32_t DIGI_MDC_LAYER_OFFSET    = 9;
-constexpr uint32_t DIGI_MDC_LAYER_MASK      = 0x00007E00;
-constexpr uint32_t DIGI_MDC_WIRE_OFFSET     = 0;
-constexpr uint32_t DIGI_MDC_WIRE_MASK       = 0x000001FF;
-constexpr uint32_t DIGI_MDC_STEREO_WIRE     = 1;
-
-constexpr uint32_t DIGI_TOF_PART_OFFSET = 14;
-constexpr uint32_t DIGI_TOF_PART_MASK   = 0x0000C000;
-constexpr uint32_t DIGI_TOF_END_OFFSET  = 0;
-constexpr uint32_t DIGI_TOF_END_MASK    = 0x00000001;
-
-constexpr uint32_t DIGI_TOF_SCINT_LAYER_OFFSET = 8;
-constexpr uint32_t DIGI_TOF_SCINT_LAYER_MASK   = 0x00000100;
-constexpr uint32_t DIGI_TOF_SCINT_PHI_OFFSET   = 1;
-constexpr uint32_t DIGI_TOF_SCINT_PHI_MASK     = 0x000000FE;
-
-constexpr uint32_t DIGI_TOF_MRPC_ENDCAP_OFFSET = 11;
-constexpr uint32_t DIGI_TOF_MRPC_ENDCAP_MASK   = 0x00000800;
-constexpr uint32_t DIGI_TOF_MRPC_MODULE_OFFSET = 5;
-constexpr uint32_t DIGI_TOF_MRPC_MODULE_MASK   = 0x000007E0;
-constexpr uint32_t DIGI_TOF_MRPC_STRIP_OFFSET  = 1;
-constexpr uint32_t DIGI_TOF_MRPC_STRIP_MASK    = 0x0000001E;
-
-constexpr uint32_t DIGI_EMC_MODULE_OFFSET = 16;
-constexpr uint32_t DIGI_EMC_MODULE_MASK   = 0x000F0000;
-constexpr uint32_t DIGI_EMC_THETA_OFFSET  = 8;
-constexpr uint32_t DIGI_EMC_THETA_MASK    = 0x00003F00;
-constexpr uint32_t DIGI_EMC_PHI_OFFSET    = 0;
-constexpr uint32_t DIGI_EMC_PHI_MASK      = 0x000000FF;
-
-constexpr uint32_t DIGI_MUC_PART_OFFSET    = 16;
-constexpr uint32_t DIGI_MUC_PART_MASK      = 0x000F0000;
-constexpr uint32_t DIGI_MUC_SEGMENT_OFFSET = 12;
-constexpr uint32_t DIGI_MUC_SEGMENT_MASK   = 0x0000F000;
-constexpr uint32_t DIGI_MUC_LAYER_OFFSET   = 8;
-constexpr uint32_t DIGI_MUC_LAYER_MASK     = 0x00000F00;
-constexpr uint32_t DIGI_MUC_CHANNEL_OFFSET = 0;
-constexpr uint32_t DIGI_MUC_CHANNEL_MASK   = 0x000000FF;
-
-constexpr uint32_t DIGI_CGEM_STRIP_OFFSET     = 7;
-constexpr uint32_t DIGI_CGEM_STRIP_MASK       = 0x0007FF80;
-constexpr uint32_t DIGI_CGEM_STRIPTYPE_OFFSET = 6;
-constexpr uint32_t DIGI_CGEM_STRIPTYPE_MASK   = 0x00000040;
-constexpr uint32_t DIGI_CGEM_SHEET_OFFSET     = 3;
-constexpr uint32_t DIGI_CGEM_SHEET_MASK       = 0x00000038;
-constexpr uint32_t DIGI_CGEM_LAYER_OFFSET     = 0;
-constexpr uint32_t DIGI_CGEM_LAYER_MASK       = 0x00000007;
-
 // ===========================================================================
 // MDC
 // ===========================================================================
@@ -83,6 +27,13 @@ inline void mdc_id_to_is_stereo( T* mdc_id, bool* out ) noexcept {
            DIGI_MDC_STEREO_WIRE;
 }
 
+template <typename T>
+inline void parse_mdc_id( T* mdc_id, T* layer, T* wire, bool* is_stereo ) noexcept {
+    mdc_id_to_layer( mdc_id, layer );
+    mdc_id_to_wire( mdc_id, wire );
+    mdc_id_to_is_stereo( mdc_id, is_stereo );
+}
+
 template <typename T>
 inline void get_mdc_id( T* wire, T* layer, T* wire_type, uint32_t* out ) noexcept {
     *out = ( ( *wire << DIGI_MDC_WIRE_OFFSET ) & DIGI_MDC_WIRE_MASK ) |
@@ -146,6 +97,15 @@ inline void _tof_id_to_phi_or_strip_2( T* tof_id, T* part, T* out ) noexcept {
     else { *out = ( *tof_id & DIGI_TOF_MRPC_STRIP_MASK ) >> DIGI_TOF_MRPC_STRIP_OFFSET; }
 }
 
+template <typename T>
+inline void parse_tof_id( T* tof_id, T* part, T* layer_or_module, T* phi_or_strip,
+                          T* end ) noexcept {
+    tof_id_to_part( tof_id, part );
+    _tof_id_to_layer_or_module_2( tof_id, part, layer_or_module );
+    _tof_id_to_phi_or_strip_2( tof_id, part, phi_or_strip );
+    tof_id_to_end( tof_id, end );
+}
+
 template <typename T>
 inline void get_tof_id( T* part, T* layer_or_module, T* phi_or_strip, T* end,
                         uint32_t* out ) noexcept {
@@ -194,6 +154,13 @@ inline void emc_id_to_phi( T* emc_id, T* out ) noexcept {
     *out = ( *emc_id & DIGI_EMC_PHI_MASK ) >> DIGI_EMC_PHI_OFFSET;
 }
 
+template <typename T>
+inline void parse_emc_id( T* emc_id, T* module, T* theta, T* phi ) noexcept {
+    emc_id_to_module( emc_id, module );
+    emc_id_to_theta( emc_id, theta );
+    emc_id_to_phi( emc_id, phi );
+}
+
 template <typename T>
 inline void get_emc_id( T* module, T* theta, T* phi, uint32_t* out ) noexcept {
     *out = ( ( *module << DIGI_EMC_MODULE_OFFSET ) & DIGI_EMC_MODULE_MASK ) |
@@ -230,6 +197,14 @@ inline void muc_id_to_channel( T* muc_id, T* out ) noexcept {
     *out = ( *muc_id & DIGI_MUC_CHANNEL_MASK ) >> DIGI_MUC_CHANNEL_OFFSET;
 }
 
+template <typename T>
+inline void parse_muc_id( T* muc_id, T* part, T* segment, T* layer, T* channel ) noexcept {
+    muc_id_to_part( muc_id, part );
+    muc_id_to_segment( muc_id, segment );
+    muc_id_to_layer( muc_id, layer );
+    muc_id_to_channel( muc_id, channel );
+}
+
 template <typename T>
 inline void get_muc_id( T* part, T* segment, T* layer, T* channel, uint32_t* out ) noexcept {
     *out = ( ( *part << DIGI_MUC_PART_OFFSET ) & DIGI_MUC_PART_MASK ) |
@@ -268,6 +243,15 @@ inline void cgem_id_to_strip( T* cgem_id, uint16_t* out ) noexcept {
         static_cast<uint16_t>( ( *cgem_id & DIGI_CGEM_STRIP_MASK ) >> DIGI_CGEM_STRIP_OFFSET );
 }
 
+template <typename T>
+inline void parse_cgem_id( T* cgem_id, T* layer, T* sheet, T* strip_type,
+                           uint16_t* strip ) noexcept {
+    cgem_id_to_layer( cgem_id, layer );
+    cgem_id_to_sheet( cgem_id, sheet );
+    cgem_id_to_strip_type( cgem_id, strip_type );
+    cgem_id_to_strip( cgem_id, strip );
+}
+
 template <typename T>
 inline void get_cgem_id( T* layer, T* sheet, T* strip_type, T* strip,
                          uint32_t* out ) noexcept {
@@ -278,6 +262,74 @@ inline void get_cgem_id( T* layer, T* sheet, T* strip_type, T* strip,
            ( DIGI_CGEM_FLAG << DIGI_FLAG_OFFSET );
 }
 
+// ===========================================================================
+// Mixed detectors
+//
+// Decode digi IDs of any detector in one pass, dispatching on the DIGI_FLAG byte. The
+// sub-fields are the outputs of `parse_xxx_id`, unused ones are -1:
+//   MDC:  layer, wire, is_stereo, -1
+//   TOF:  part, layer_or_module, phi_or_strip, end
+//   EMC:  part, theta, phi, -1
+//   MUC:  part, segment, gap, strip
+//   CGEM: layer, sheet, strip_type, strip
+// The gid is the one of `xxx_id_to_gid`, -1 if the digi ID is of no known detector or of
+// none of its channels.
+// ===========================================================================
+constexpr int8_t DIGI_DET_UNKNOWN = -1;
+constexpr int8_t DIGI_DET_MDC     = 0;
+constexpr int8_t DIGI_DET_TOF     = 1;
+constexpr int8_t DIGI_DET_EMC     = 2;
+constexpr int8_t DIGI_DET_MUC     = 3;
+constexpr int8_t DIGI_DET_CGEM    = 4;
+
+template <typename T>
+inline void decode_digi_id( T* digi_id, int8_t* detector, int64_t* gid, int16_t* field0,
+                            int16_t* field1, int16_t* field2, int16_t* field3 ) noexcept {
+    T f0 = -1, f1 = -1, f2 = -1, f3 = -1;
+    bool is_stereo;
+    uint16_t cgem_strip;
+
+    switch ( ( *digi_id & DIGI_FLAG_MASK ) >> DIGI_FLAG_OFFSET )
+    {
+    case DIGI_MDC_FLAG:
+        parse_mdc_id( digi_id, &f0, &f1, &is_stereo );
+        f2        = is_stereo;
+        *detector = DIGI_DET_MDC;
+        *gid      = mdc_digi_gid( *digi_id );
+        break;
+    case DIGI_TOF_FLAG:
+        parse_tof_id( digi_id, &f0, &f1, &f2, &f3 );
+        *detector = DIGI_DET_TOF;
+        *gid      = tof_digi_gid( *digi_id );
+        break;
+    case DIGI_EMC_FLAG:
+        parse_emc_id( digi_id, &f0, &f1, &f2 );
+        *detector = DIGI_DET_EMC;
+        *gid      = emc_digi_gid( *digi_id );
+        break;
+    case DIGI_MUC_FLAG:
+        parse_muc_id( digi_id, &f0, &f1, &f2, &f3 );
+        *detector = DIGI_DET_MUC;
+        *gid      = muc_digi_gid( *digi_id );
+        break;
+    case DIGI_CGEM_FLAG:
+        parse_cgem_id( digi_id, &f0, &f1, &f2, &cgem_strip );
+        f3        = cgem_strip;
+        *detector = DIGI_DET_CGEM;
+        *gid      = cgem_digi_gid( *digi_id );
+        break;
+    default:
+        *detector = DIGI_DET_UNKNOWN;
+        *gid      = -1;
+        break;
+    }
+
+    *field0 = static_cast<int16_t>( f0 );
+    *field1 = static_cast<int16_t>( f1 );
+    *field2 = static_cast<int16_t>( f2 );
+    *field3 = static_cast<int16_t>( f3 );
+}
+
 // ===========================================================================
 // declare_identifier – register all ufuncs into the module dict
 // ===========================================================================
@@ -310,6 +362,12 @@ void declare_identifier( PyObject* d ) {
         mdc_id_to_is_stereo<int64_t>>  //
         ( d, "mdc_id_to_is_stereo" );
 
+    decl_ufunc<1, 3,                   //
+               parse_mdc_id<uint32_t>, //
+               parse_mdc_id<uint64_t>, //
+               parse_mdc_id<int64_t>>  //
+        ( d, "parse_mdc_id" );
+
     decl_ufunc_31<            //
         get_mdc_id<uint32_t>, //
         get_mdc_id<uint64_t>, //
@@ -359,6 +417,12 @@ void declare_identifier( PyObject* d ) {
         _tof_id_to_phi_or_strip_2<int64_t>>  //
         ( d, "_tof_id_to_phi_or_strip_2" );
 
+    decl_ufunc<1, 4,                   //
+               parse_tof_id<uint32_t>, //
+               parse_tof_id<uint64_t>, //
+               parse_tof_id<int64_t>>  //
+        ( d, "parse_tof_id" );
+
     decl_ufunc_41<            //
         get_tof_id<uint32_t>, //
         get_tof_id<uint64_t>, //
@@ -390,6 +454,12 @@ void declare_identifier( PyObject* d ) {
         emc_id_to_phi<int64_t>>  //
         ( d, "emc_id_to_phi" );
 
+    decl_ufunc<1, 3,                   //
+               parse_emc_id<uint32_t>, //
+               parse_emc_id<uint64_t>, //
+               parse_emc_id<int64_t>>  //
+        ( d, "parse_emc_id" );
+
     decl_ufunc_31<            //
         get_emc_id<uint32_t>, //
         get_emc_id<uint64_t>, //
@@ -427,6 +497,12 @@ void declare_identifier( PyObject* d ) {
         muc_id_to_channel<int64_t>>  //
         ( d, "muc_id_to_channel" );
 
+    decl_ufunc<1, 4,                   //
+               parse_muc_id<uint32_t>, //
+               parse_muc_id<uint64_t>, //
+               parse_muc_id<int64_t>>  //
+        ( d, "parse_muc_id" );
+
     decl_ufunc_41<            //
         get_muc_id<uint32_t>, //
         get_muc_id<uint64_t>, //
@@ -464,9 +540,22 @@ void declare_identifier( PyObject* d ) {
         cgem_id_to_strip<int64_t>>  //
         ( d, "cgem_id_to_strip" );
 
+    decl_ufunc<1, 4,                    //
+               parse_cgem_id<uint32_t>, //
+               parse_cgem_id<uint64_t>, //
+               parse_cgem_id<int64_t>>  //
+        ( d, "parse_cgem_id" );
+
     decl_ufunc_41<             //
         get_cgem_id<uint32_t>, //
         get_cgem_id<uint64_t>, //
         get_cgem_id<int64_t>>  //
         ( d, "get_cgem_id" );
+
+    // ---- Mixed detectors ----
+    decl_ufunc<1, 6,                     //
+               decode_digi_id<uint32_t>, //
+               decode_digi_id<uint64_t>, //
+               decode_digi_id<int64_t>>  //
+        ( d, "decode_digi_id" );
 }
@@ -1,3 +1,13 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <vector>
+
+#include "helix.hh"
+#include "digi.hh"
+#include "geom.hh"
+#include "gid.hh"
 #include "mod.hh"
 #include "ufunc.hh"
 
@@ -72,6 +82,42 @@ std::array<double, N_WIRES> _west_z{};
 std::array<double, N_WIRES> _dx_dz{};
 std::array<double, N_WIRES> _dy_dz{};
 
+/* Per-layer wire index sorted by the phi of the wire mid-points */
+std::array<double, N_WIRES> _sorted_mid_phi{};
+std::array<uint16_t, N_WIRES> _sorted_gid{};
+
+inline double wire_phi_at( size_t gid, double z ) noexcept {
+    double x = _west_x[gid] + _dx_dz[gid] * ( z - _west_z[gid] );
+    double y = _west_y[gid] + _dy_dz[gid] * ( z - _west_z[gid] );
+    return std::atan2( y, x );
+}
+
+inline double wire_mid_z( size_t gid ) noexcept { return ( _west_z[gid] + _east_z[gid] ) / 2; }
+
+void _build_mdc_wire_index() {
+    for ( size_t layer = 0; layer < N_LAYERS; ++layer )
+    {
+        size_t start = _layer_start_gid[layer];
+        size_t n     = _layer_nwires[layer];
+
+        std::vector<std::pair<double, uint16_t>> wires( n );
+        for ( size_t i = 0; i < n; ++i )
+        {
+            size_t gid = start + i;
+            double phi = wire_phi_at( gid, wire_mid_z( gid ) );
+            if ( phi < 0 ) phi += TWO_PI;
+            wires[i] = { phi, static_cast<uint16_t>( gid ) };
+        }
+        std::sort( wires.begin(), wires.end() );
+
+        for ( size_t i = 0; i < n; ++i )
+        {
+            _sorted_mid_phi[start + i] = wires[i].first;
+            _sorted_gid[start + i]     = wires[i].second;
+        }
+    }
+}
+
 PyObject* _init_mdc_geom( PyObject* self, PyObject* args ) {
     PyArrayObject *east_x = nullptr, *east_y = nullptr, *east_z = nullptr;
     PyArrayObject *west_x = nullptr, *west_y = nullptr, *west_z = nullptr;
@@ -99,6 +145,7 @@ PyObject* _init_mdc_geom( PyObject* self, PyObject* args ) {
         _dy_dz[i] = ( _east_y[i] - _west_y[i] ) / ( _east_z[i] - _west_z[i] );
     }
 
+    _build_mdc_wire_index();
     Py_RETURN_NONE;
 }
 
@@ -107,6 +154,34 @@ inline void get_mdc_gid( T* layer, T* wire, T* out ) noexcept {
     *out = _layer_start_gid[*layer] + *wire;
 }
 
+// digi ID -> gid: one row per layer, wires are the local index
+constexpr DigiLayout MDC_DIGI_LAYOUT = { DIGI_MDC_FLAG, DIGI_MDC_LAYER_MASK,
+                                         DIGI_MDC_LAYER_OFFSET, DIGI_MDC_WIRE_MASK,
+                                         DIGI_MDC_WIRE_OFFSET };
+
+constexpr auto _mdc_digi_id = []( size_t gid ) -> uint32_t {
+    return ( _layer[gid] << DIGI_MDC_LAYER_OFFSET ) | ( _wire[gid] << DIGI_MDC_WIRE_OFFSET );
+};
+
+consteval auto _init_mdc_digi_rows() {
+    DigiRows<MDC_DIGI_LAYOUT> rows{};
+    for ( size_t gid = 0; gid < N_WIRES; ++gid )
+        add_digi_row<MDC_DIGI_LAYOUT>( rows, _mdc_digi_id( gid ), gid );
+    return rows;
+}
+
+constexpr auto _mdc_digi_rows = _init_mdc_digi_rows();
+static_assert( check_digi_rows<MDC_DIGI_LAYOUT>( _mdc_digi_rows, N_WIRES, _mdc_digi_id ) );
+
+template <typename T>
+inline void mdc_id_to_gid( T* mdc_id, int64_t* gid ) noexcept {
+    *gid = digi_row_gid<MDC_DIGI_LAYOUT>( _mdc_digi_rows, *mdc_id );
+}
+
+int64_t mdc_digi_gid( uint64_t digi_id ) noexcept {
+    return digi_row_gid<MDC_DIGI_LAYOUT>( _mdc_digi_rows, digi_id );
+}
+
 template <typename T>
 inline void mdc_gid_to_superlayer( T* gid, T* out ) noexcept {
     *out = _superlayer[*gid];
@@ -188,6 +263,153 @@ inline void mdc_gid_z_to_y( T* gid, double* z, double* out ) noexcept {
     *out = _west_y[*gid] + _dy_dz[*gid] * ( *z - _west_z[*gid] );
 }
 
+template <typename TIN, typename TS>
+inline void parse_mdc_gid( TIN* gid, TIN* layer, TIN* wire, TS* stereo, bool* is_stereo,
+                           TIN* superlayer ) noexcept {
+    *layer      = _layer[*gid];
+    *wire       = _wire[*gid];
+    *stereo     = _stereo[*gid];
+    *is_stereo  = _is_stereo[*gid];
+    *superlayer = _superlayer[*gid];
+}
+
+template <typename T>
+inline void mdc_gid_to_geometry( T* gid, double* mid_x, double* mid_y, double* west_x,
+                                 double* west_y, double* west_z, double* east_x,
+                                 double* east_y, double* east_z ) noexcept {
+    *west_x = _west_x[*gid];
+    *west_y = _west_y[*gid];
+    *west_z = _west_z[*gid];
+    *east_x = _east_x[*gid];
+    *east_y = _east_y[*gid];
+    *east_z = _east_z[*gid];
+    *mid_x  = ( *west_x + *east_x ) / 2;
+    *mid_y  = ( *west_y + *east_y ) / 2;
+}
+
+// Nearest wire of a layer to a point, by the distance in the x-y plane at the z of the
+// point. The twist of stereo wires is removed with the first wire of the layer, then the
+// sorted mid-point phi are searched with a binary search. Invalid layers and non-finite
+// points give gid -1 and distance nan.
+template <typename T>
+inline void mdc_layer_nearest_wire( T* layer, double* x, double* y, double* z, T* gid,
+                                    double* distance ) noexcept {
+    *gid      = static_cast<T>( -1 );
+    *distance = std::numeric_limits<double>::quiet_NaN();
+
+    int64_t l = static_cast<int64_t>( *layer );
+    if ( l < 0 || l >= static_cast<int64_t>( N_LAYERS ) ) return;
+    if ( !std::isfinite( *x ) || !std::isfinite( *y ) || !std::isfinite( *z ) ) return;
+
+    size_t start = _layer_start_gid[l];
+    size_t n     = _layer_nwires[l];
+
+    size_t ref   = _sorted_gid[start];
+    double twist = wire_phi_at( ref, *z ) - wire_phi_at( ref, wire_mid_z( ref ) );
+    double phi   = std::fmod( std::atan2( *y, *x ) - twist, TWO_PI );
+    if ( phi < 0 ) phi += TWO_PI;
+
+    const double* phis = _sorted_mid_phi.data() + start;
+    size_t pos         = std::lower_bound( phis, phis + n, phi ) - phis;
+
+    *distance = std::numeric_limits<double>::infinity();
+    for ( size_t i = pos + n - 2; i <= pos + n + 1; ++i )
+    {
+        size_t g = _sorted_gid[start + i % n];
+        double d = std::hypot( *x - ( _west_x[g] + _dx_dz[g] * ( *z - _west_z[g] ) ),
+                               *y - ( _west_y[g] + _dy_dz[g] * ( *z - _west_z[g] ) ) );
+        if ( d < *distance )
+        {
+            *distance = d;
+            *gid      = static_cast<T>( g );
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Distance of closest approach between a helix and a wire. Points on the helix follow
+// the BOSS `Helix::x(phi)` parametrisation (see helix.cc), the wire is the straight line
+// through its west and east ends.
+// ---------------------------------------------------------------------------
+template <typename T>
+inline void mdc_helix_doca( double* dr, double* phi0, double* kappa, double* dz, double* tanl,
+                            double* pivot_x, double* pivot_y, double* pivot_z, T* gid,
+                            double* doca, double* z ) noexcept {
+    if ( *kappa == 0 )
+    {
+        *doca = *z = std::numeric_limits<double>::quiet_NaN();
+        return;
+    }
+
+    double r  = kKappaToRadiusFactor / *kappa;
+    double cx = *pivot_x + ( *dr + r ) * std::cos( *phi0 );
+    double cy = *pivot_y + ( *dr + r ) * std::sin( *phi0 );
+    double z0 = *pivot_z + *dz;
+
+    // wire: (west_x, west_y, west_z) + t * (wx, wy, wz)
+    double ox   = _west_x[*gid];
+    double oy   = _west_y[*gid];
+    double oz   = _west_z[*gid];
+    double norm = std::sqrt( _dx_dz[*gid] * _dx_dz[*gid] + _dy_dz[*gid] * _dy_dz[*gid] + 1.0 );
+    double wx   = _dx_dz[*gid] / norm;
+    double wy   = _dy_dz[*gid] / norm;
+    double wz   = 1.0 / norm;
+
+    // initial turning angle: the point of the circle closest to the wire at the helix z,
+    // wrapped into (-pi, pi]
+    auto closest_2d = [&]( double hz ) {
+        double px = ox + _dx_dz[*gid] * ( hz - oz );
+        double py = oy + _dy_dz[*gid] * ( hz - oz );
+        double a  = std::atan2( ( cy - py ) / r, ( cx - px ) / r ) - *phi0;
+        a         = std::remainder( a, TWO_PI );
+        return a == -std::numbers::pi ? std::numbers::pi : a;
+    };
+    double phi = closest_2d( z0 );
+    phi        = closest_2d( z0 - r * *tanl * phi );
+
+    // Newton iterations on the squared distance between the helix point and the wire
+    double vx, vy, vz, c, s;
+    auto eval_v = [&] {
+        c  = std::cos( *phi0 + phi );
+        s  = std::sin( *phi0 + phi );
+        vx = cx - r * c - ox;
+        vy = cy - r * s - oy;
+        vz = z0 - r * *tanl * phi - oz;
+    };
+
+    for ( int i = 0; i < 20; ++i )
+    {
+        eval_v();
+        double d1x = r * s, d1y = -r * c, d1z = -r * *tanl; // dH/dphi
+        double d2x = r * c, d2y = r * s;                    // d2H/dphi2
+
+        double v_w  = vx * wx + vy * wy + vz * wz;
+        double d1_w = d1x * wx + d1y * wy + d1z * wz;
+        double d2_w = d2x * wx + d2y * wy;
+
+        double grad = vx * d1x + vy * d1y + vz * d1z - v_w * d1_w;
+        double hess = d1x * d1x + d1y * d1y + d1z * d1z + vx * d2x + vy * d2y - d1_w * d1_w -
+                      v_w * d2_w;
+        if ( !( hess > 0 ) ) break;
+
+        double step = grad / hess;
+        phi -= step;
+        if ( std::abs( step ) < 1e-12 ) break;
+    }
+    eval_v();
+
+    // component of (helix - wire) perpendicular to the wire
+    double v_w = vx * wx + vy * wy + vz * wz;
+    double px  = vx - v_w * wx;
+    double py  = vy - v_w * wy;
+    double pz  = vz - v_w * wz;
+
+    // positive if the wire is on the left of the flight direction (-s, c) in the xy plane
+    double side = c * px + s * py;
+    *doca       = std::copysign( std::sqrt( px * px + py * py + pz * pz ), side );
+    *z          = z0 - r * *tanl * phi;
+}
+
 void declare_mdc( PyObject* d ) {
     if ( _import_array() < 0 ) return;
     if ( _import_umath() < 0 ) return;
@@ -200,6 +422,12 @@ void declare_mdc( PyObject* d ) {
         get_mdc_gid<uint64_t>, //
         get_mdc_gid<int64_t>>( d, "get_mdc_gid" );
 
+    decl_ufunc_11<               //
+        mdc_id_to_gid<uint32_t>, //
+        mdc_id_to_gid<uint64_t>, //
+        mdc_id_to_gid<int64_t>>  //
+        ( d, "mdc_id_to_gid" );
+
     decl_ufunc_11<                       //
         mdc_gid_to_superlayer<uint16_t>, //
         mdc_gid_to_superlayer<int16_t>,  //
@@ -319,4 +547,36 @@ void declare_mdc( PyObject* d ) {
         mdc_gid_z_to_y<int32_t>,  //
         mdc_gid_z_to_y<uint64_t>, //
         mdc_gid_z_to_y<int64_t>>( d, "mdc_gid_z_to_y" );
+
+    decl_ufunc<4, 2,                             //
+               mdc_layer_nearest_wire<uint16_t>, //
+               mdc_layer_nearest_wire<int16_t>,  //
+               mdc_layer_nearest_wire<uint32_t>, //
+               mdc_layer_nearest_wire<int32_t>,  //
+               mdc_layer_nearest_wire<uint64_t>, //
+               mdc_layer_nearest_wire<int64_t>>( d, "mdc_layer_nearest_wire" );
+
+    decl_ufunc<9, 2,                     //
+               mdc_helix_doca<uint16_t>, //
+               mdc_helix_doca<int16_t>,  //
+               mdc_helix_doca<uint32_t>, //
+               mdc_helix_doca<int32_t>,  //
+               mdc_helix_doca<uint64_t>, //
+               mdc_helix_doca<int64_t>>( d, "mdc_helix_doca" );
+
+    decl_ufunc<1, 5,                             //
+               parse_mdc_gid<uint16_t, int16_t>, //
+               parse_mdc_gid<int16_t, int16_t>,  //
+               parse_mdc_gid<uint32_t, int32_t>, //
+               parse_mdc_gid<int32_t, int32_t>,  //
+               parse_mdc_gid<uint64_t, int64_t>, //
+               parse_mdc_gid<int64_t, int64_t>>( d, "parse_mdc_gid" );
+
+    decl_ufunc<1, 8,                          //
+               mdc_gid_to_geometry<uint16_t>, //
+               mdc_gid_to_geometry<int16_t>,  //
+               mdc_gid_to_geometry<uint32_t>, //
+               mdc_gid_to_geometry<int32_t>,  //
+               mdc_gid_to_geometry<uint64_t>, //
+               mdc_gid_to_geometry<int64_t>>( d, "mdc_gid_to_geometry" );
 }
@@ -4,10 +4,42 @@
 #include "numpy/ufuncobject.h"
 
 static PyMethodDef MyMethods[] = {
+    { "_cgem_cluster_strips", _cgem_cluster_strips, METH_VARARGS,
+      "Cluster CGEM strips of adjacent strips event by event." },
+    { "_cgem_xv_intersection", _cgem_xv_intersection, METH_VARARGS,
+      "Intersect CGEM X and V strip clusters event by event." },
     { "_init_emc_geom", _init_emc_geom, METH_VARARGS,
       "Initialize EMC geometry arrays from numpy arrays." },
+    { "_emc_match_crystals", _emc_match_crystals, METH_VARARGS,
+      "Find the nearest EMC crystals of points on the EMC front face." },
+    { "_emc_neighbours", _emc_neighbours, METH_NOARGS,
+      "Get the neighbour table of EMC crystals, padded with -1." },
+    { "_emc_cluster_hits", _emc_cluster_hits, METH_VARARGS,
+      "Cluster EMC hits of neighbouring crystals event by event." },
+    { "_emc_shower_shape", _emc_shower_shape, METH_VARARGS,
+      "Compute EMC shower shape variables around seed crystals event by event." },
     { "_init_mdc_geom", _init_mdc_geom, METH_VARARGS,
       "Initialize MDC geometry arrays from numpy arrays." },
+    { "_init_muc_geom", _init_muc_geom, METH_VARARGS,
+      "Initialize MUC geometry arrays from numpy arrays." },
+    { "_init_tof_geom", _init_tof_geom, METH_VARARGS,
+      "Initialize TOF counter geometry arrays from numpy arrays." },
+    { "_tof_pair_ends", _tof_pair_ends, METH_VARARGS,
+      "Pair east and west readouts of TOF counters event by event." },
+    { "_tof_predict_counters", _tof_predict_counters, METH_VARARGS,
+      "Find the TOF counters containing extrapolated track positions." },
+    { "_reduce_events", _reduce_events, METH_VARARGS,
+      "Reduce flat values event by event, optionally grouped by keys." },
+    { "_fill_channel_hist", _fill_channel_hist, METH_VARARGS,
+      "Fill per-channel occupancy and value histograms in place." },
+    { "_set_num_threads", _set_num_threads, METH_VARARGS,
+      "Set the number of threads used by large contiguous ufunc loops." },
+    { "_get_num_threads", _get_num_threads, METH_NOARGS,
+      "Get the number of threads used by large contiguous ufunc loops." },
+    { "_set_parallel_threshold", _set_parallel_threshold, METH_VARARGS,
+      "Set the minimal loop length to be split across threads." },
+    { "_get_parallel_threshold", _get_parallel_threshold, METH_NOARGS,
+      "Get the minimal loop length to be split across threads." },
     { NULL, NULL, 0, NULL } /* Sentinel */
 };
 
@@ -27,9 +59,11 @@ PyMODINIT_FUNC PyInit_ufuncs( void ) {
     declare_mdc( d );
     declare_tof( d );
     declare_emc( d );
+    declare_muc( d );
 
     declare_helix( d );
     declare_identifier( d );
+    declare_reduce( d );
 
     return m;
 }
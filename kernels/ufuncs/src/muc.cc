@@ -0,0 +1,381 @@
+#include <array>
+#include <cstring>
+#include <tuple>
+
+#include "digi.hh"
+#include "geom.hh"
+#include "gid.hh"
+#include "mod.hh"
+#include "ufunc.hh"
+
+constexpr size_t N_PARTS       = 3;
+constexpr size_t BARREL        = 1;
+constexpr size_t MAX_SEGMENTS  = 8;
+constexpr size_t MAX_GAPS      = 9;
+constexpr size_t N_BOX_INDICES = N_PARTS * MAX_SEGMENTS * MAX_GAPS;
+
+constexpr std::array<size_t, N_PARTS> N_SEGMENTS = { 4, 8, 4 };
+constexpr std::array<size_t, N_PARTS> N_GAPS     = { 8, 9, 8 };
+
+constexpr size_t ENDCAP_STRIPS         = 64;
+constexpr size_t BARREL_Z_STRIPS       = 48;
+constexpr size_t BARREL_PHI_STRIPS     = 96;
+constexpr size_t BARREL_TOP_PHI_STRIPS = 112;
+constexpr size_t BARREL_TOP_SEGMENT    = 2;
+
+/*
+ * Number of strips in a box, same as `MucID::getStripNum` in BOSS. Barrel strips are along
+ * z in even gaps and along phi in odd gaps, the top segment has more phi strips.
+ */
+constexpr size_t n_muc_strips( size_t part, size_t segment, size_t gap ) {
+    if ( part != BARREL ) return ENDCAP_STRIPS;
+    if ( gap % 2 == 0 ) return BARREL_Z_STRIPS;
+    return segment == BARREL_TOP_SEGMENT ? BARREL_TOP_PHI_STRIPS : BARREL_PHI_STRIPS;
+}
+
+consteval size_t _count_strips() {
+    size_t n = 0;
+    for ( size_t part = 0; part < N_PARTS; ++part )
+        for ( size_t segment = 0; segment < N_SEGMENTS[part]; ++segment )
+            for ( size_t gap = 0; gap < N_GAPS[part]; ++gap )
+                n += n_muc_strips( part, segment, gap );
+    return n;
+}
+
+constexpr size_t N_STRIPS = _count_strips();
+static_assert( N_STRIPS == 9152 );
+
+constexpr size_t box_index( size_t part, size_t segment, size_t gap ) {
+    return ( part * MAX_SEGMENTS + segment ) * MAX_GAPS + gap;
+}
+
+consteval auto _init() {
+    std::array<uint8_t, N_STRIPS> _part{};
+    std::array<uint8_t, N_STRIPS> _segment{};
+    std::array<uint8_t, N_STRIPS> _gap{};
+    std::array<uint8_t, N_STRIPS> _strip{};
+    std::array<uint16_t, N_BOX_INDICES> _box_offset{};
+
+    size_t gid = 0;
+    for ( size_t part = 0; part < N_PARTS; ++part )
+    {
+        for ( size_t segment = 0; segment < N_SEGMENTS[part]; ++segment )
+        {
+            for ( size_t gap = 0; gap < N_GAPS[part]; ++gap )
+            {
+                _box_offset[box_index( part, segment, gap )] = gid;
+                for ( size_t strip = 0; strip < n_muc_strips( part, segment, gap ); ++strip )
+                {
+                    _part[gid]    = part;
+                    _segment[gid] = segment;
+                    _gap[gid]     = gap;
+                    _strip[gid]   = strip;
+                    gid++;
+                }
+            }
+        }
+    }
+    return std::make_tuple( _part, _segment, _gap, _strip, _box_offset );
+}
+
+constexpr auto _init_tuple = _init();
+constexpr auto _part       = std::get<0>( _init_tuple );
+constexpr auto _segment    = std::get<1>( _init_tuple );
+constexpr auto _gap        = std::get<2>( _init_tuple );
+constexpr auto _strip      = std::get<3>( _init_tuple );
+constexpr auto _box_offset = std::get<4>( _init_tuple );
+
+template <typename T>
+inline void get_muc_gid( T* part, T* segment, T* gap, T* strip, T* gid ) noexcept {
+    *gid = _box_offset[box_index( *part, *segment, *gap )] + *strip;
+}
+
+// digi ID -> gid: one row per box (part, segment, gap), strip is the local index
+constexpr DigiLayout MUC_DIGI_LAYOUT = {
+    DIGI_MUC_FLAG, DIGI_MUC_PART_MASK | DIGI_MUC_SEGMENT_MASK | DIGI_MUC_LAYER_MASK,
+    DIGI_MUC_LAYER_OFFSET, DIGI_MUC_CHANNEL_MASK, DIGI_MUC_CHANNEL_OFFSET };
+
+constexpr auto _muc_digi_id = []( size_t gid ) -> uint32_t {
+    return ( _part[gid] << DIGI_MUC_PART_OFFSET ) |
+           ( _segment[gid] << DIGI_MUC_SEGMENT_OFFSET ) |
+           ( _gap[gid] << DIGI_MUC_LAYER_OFFSET ) | ( _strip[gid] << DIGI_MUC_CHANNEL_OFFSET );
+};
+
+consteval auto _init_muc_digi_rows() {
+    DigiRows<MUC_DIGI_LAYOUT> rows{};
+    for ( size_t gid = 0; gid < N_STRIPS; ++gid )
+        add_digi_row<MUC_DIGI_LAYOUT>( rows, _muc_digi_id( gid ), gid );
+    return rows;
+}
+
+constexpr auto _muc_digi_rows = _init_muc_digi_rows();
+static_assert( check_digi_rows<MUC_DIGI_LAYOUT>( _muc_digi_rows, N_STRIPS, _muc_digi_id ) );
+
+template <typename T>
+inline void muc_id_to_gid( T* muc_id, int64_t* gid ) noexcept {
+    *gid = digi_row_gid<MUC_DIGI_LAYOUT>( _muc_digi_rows, *muc_id );
+}
+
+int64_t muc_digi_gid( uint64_t digi_id ) noexcept {
+    return digi_row_gid<MUC_DIGI_LAYOUT>( _muc_digi_rows, digi_id );
+}
+
+template <typename T>
+inline void muc_gid_to_part( T* gid, T* part ) noexcept {
+    *part = _part[*gid];
+}
+
+template <typename T>
+inline void muc_gid_to_segment( T* gid, T* segment ) noexcept {
+    *segment = _segment[*gid];
+}
+
+template <typename T>
+inline void muc_gid_to_gap( T* gid, T* gap ) noexcept {
+    *gap = _gap[*gid];
+}
+
+template <typename T>
+inline void muc_gid_to_strip( T* gid, T* strip ) noexcept {
+    *strip = _strip[*gid];
+}
+
+template <typename T>
+inline void muc_gid_to_is_barrel( T* gid, bool* is_barrel ) noexcept {
+    *is_barrel = _part[*gid] == BARREL;
+}
+
+template <typename T>
+inline void parse_muc_gid( T* gid, T* part, T* segment, T* gap, T* strip ) noexcept {
+    *part    = _part[*gid];
+    *segment = _segment[*gid];
+    *gap     = _gap[*gid];
+    *strip   = _strip[*gid];
+}
+
+/*
+ * Geometry arrays. The MUC geometry is not shipped, so they stay `nan` until
+ * `_init_muc_geom` is called.
+ */
+std::array<double, N_STRIPS> _strip_center_x = _nan_array<N_STRIPS>();
+std::array<double, N_STRIPS> _strip_center_y = _nan_array<N_STRIPS>();
+std::array<double, N_STRIPS> _strip_center_z = _nan_array<N_STRIPS>();
+std::array<double, N_STRIPS> _strip_dir_x    = _nan_array<N_STRIPS>();
+std::array<double, N_STRIPS> _strip_dir_y    = _nan_array<N_STRIPS>();
+std::array<double, N_STRIPS> _strip_dir_z    = _nan_array<N_STRIPS>();
+std::array<double, N_STRIPS> _strip_length   = _nan_array<N_STRIPS>();
+
+PyObject* _init_muc_geom( PyObject* self, PyObject* args ) {
+    PyArrayObject *center_x = nullptr, *center_y = nullptr, *center_z = nullptr;
+    PyArrayObject *dir_x = nullptr, *dir_y = nullptr, *dir_z = nullptr;
+    PyArrayObject* length = nullptr;
+
+    if ( !PyArg_ParseTuple( args, "O!O!O!O!O!O!O!",   //
+                            &PyArray_Type, &center_x, //
+                            &PyArray_Type, &center_y, //
+                            &PyArray_Type, &center_z, //
+                            &PyArray_Type, &dir_x,    //
+                            &PyArray_Type, &dir_y,    //
+                            &PyArray_Type, &dir_z,    //
+                            &PyArray_Type, &length    //
+                            ) )                       //
+        return nullptr;
+
+    auto arrays = { std::pair{ center_x, &_strip_center_x },
+                    std::pair{ center_y, &_strip_center_y },
+                    std::pair{ center_z, &_strip_center_z },
+                    std::pair{ dir_x, &_strip_dir_x },
+                    std::pair{ dir_y, &_strip_dir_y },
+                    std::pair{ dir_z, &_strip_dir_z },
+                    std::pair{ length, &_strip_length } };
+
+    for ( auto [arr, dst] : arrays )
+    {
+        if ( PyArray_TYPE( arr ) != NPY_DOUBLE || PyArray_NDIM( arr ) != 1 ||
+             !PyArray_IS_C_CONTIGUOUS( arr ) ||
+             PyArray_SIZE( arr ) != static_cast<npy_intp>( N_STRIPS ) )
+        {
+            PyErr_SetString( PyExc_ValueError,
+                             "MUC geometry arrays must be contiguous 1D float64 arrays with "
+                             "one entry per strip" );
+            return nullptr;
+        }
+    }
+
+    for ( auto [arr, dst] : arrays )
+        memcpy( dst->data(), PyArray_DATA( arr ), dst->size() * sizeof( double ) );
+
+    Py_RETURN_NONE;
+}
+
+template <typename T>
+inline void muc_gid_to_center_x( T* gid, double* out ) noexcept {
+    *out = _strip_center_x[*gid];
+}
+
+template <typename T>
+inline void muc_gid_to_center_y( T* gid, double* out ) noexcept {
+    *out = _strip_center_y[*gid];
+}
+
+template <typename T>
+inline void muc_gid_to_center_z( T* gid, double* out ) noexcept {
+    *out = _strip_center_z[*gid];
+}
+
+template <typename T>
+inline void muc_gid_to_dir_x( T* gid, double* out ) noexcept {
+    *out = _strip_dir_x[*gid];
+}
+
+template <typename T>
+inline void muc_gid_to_dir_y( T* gid, double* out ) noexcept {
+    *out = _strip_dir_y[*gid];
+}
+
+template <typename T>
+inline void muc_gid_to_dir_z( T* gid, double* out ) noexcept {
+    *out = _strip_dir_z[*gid];
+}
+
+template <typename T>
+inline void muc_gid_to_length( T* gid, double* out ) noexcept {
+    *out = _strip_length[*gid];
+}
+
+void declare_muc( PyObject* d ) {
+    if ( _import_array() < 0 ) return;
+    if ( _import_umath() < 0 ) return;
+
+    decl_ufunc_41<             //
+        get_muc_gid<uint16_t>, //
+        get_muc_gid<int16_t>,  //
+        get_muc_gid<uint32_t>, //
+        get_muc_gid<int32_t>,  //
+        get_muc_gid<uint64_t>, //
+        get_muc_gid<int64_t>>  //
+        ( d, "get_muc_gid" );
+
+    decl_ufunc_11<               //
+        muc_id_to_gid<uint32_t>, //
+        muc_id_to_gid<uint64_t>, //
+        muc_id_to_gid<int64_t>>  //
+        ( d, "muc_id_to_gid" );
+
+    decl_ufunc_11<                 //
+        muc_gid_to_part<uint16_t>, //
+        muc_gid_to_part<int16_t>,  //
+        muc_gid_to_part<uint32_t>, //
+        muc_gid_to_part<int32_t>,  //
+        muc_gid_to_part<uint64_t>, //
+        muc_gid_to_part<int64_t>>  //
+        ( d, "muc_gid_to_part" );
+
+    decl_ufunc_11<                    //
+        muc_gid_to_segment<uint16_t>, //
+        muc_gid_to_segment<int16_t>,  //
+        muc_gid_to_segment<uint32_t>, //
+        muc_gid_to_segment<int32_t>,  //
+        muc_gid_to_segment<uint64_t>, //
+        muc_gid_to_segment<int64_t>>  //
+        ( d, "muc_gid_to_segment" );
+
+    decl_ufunc_11<                //
+        muc_gid_to_gap<uint16_t>, //
+        muc_gid_to_gap<int16_t>,  //
+        muc_gid_to_gap<uint32_t>, //
+        muc_gid_to_gap<int32_t>,  //
+        muc_gid_to_gap<uint64_t>, //
+        muc_gid_to_gap<int64_t>>  //
+        ( d, "muc_gid_to_gap" );
+
+    decl_ufunc_11<                  //
+        muc_gid_to_strip<uint16_t>, //
+        muc_gid_to_strip<int16_t>,  //
+        muc_gid_to_strip<uint32_t>, //
+        muc_gid_to_strip<int32_t>,  //
+        muc_gid_to_strip<uint64_t>, //
+        muc_gid_to_strip<int64_t>>  //
+        ( d, "muc_gid_to_strip" );
+
+    decl_ufunc_11<                      //
+        muc_gid_to_is_barrel<uint16_t>, //
+        muc_gid_to_is_barrel<int16_t>,  //
+        muc_gid_to_is_barrel<uint32_t>, //
+        muc_gid_to_is_barrel<int32_t>,  //
+        muc_gid_to_is_barrel<uint64_t>, //
+        muc_gid_to_is_barrel<int64_t>>  //
+        ( d, "muc_gid_to_is_barrel" );
+
+    decl_ufunc<1, 4,                    //
+               parse_muc_gid<uint16_t>, //
+               parse_muc_gid<int16_t>,  //
+               parse_muc_gid<uint32_t>, //
+               parse_muc_gid<int32_t>,  //
+               parse_muc_gid<uint64_t>, //
+               parse_muc_gid<int64_t>>  //
+        ( d, "parse_muc_gid" );
+
+    decl_ufunc_11<                     //
+        muc_gid_to_center_x<uint16_t>, //
+        muc_gid_to_center_x<int16_t>,  //
+        muc_gid_to_center_x<uint32_t>, //
+        muc_gid_to_center_x<int32_t>,  //
+        muc_gid_to_center_x<uint64_t>, //
+        muc_gid_to_center_x<int64_t>>  //
+        ( d, "muc_gid_to_center_x" );
+
+    decl_ufunc_11<                     //
+        muc_gid_to_center_y<uint16_t>, //
+        muc_gid_to_center_y<int16_t>,  //
+        muc_gid_to_center_y<uint32_t>, //
+        muc_gid_to_center_y<int32_t>,  //
+        muc_gid_to_center_y<uint64_t>, //
+        muc_gid_to_center_y<int64_t>>  //
+        ( d, "muc_gid_to_center_y" );
+
+    decl_ufunc_11<                     //
+        muc_gid_to_center_z<uint16_t>, //
+        muc_gid_to_center_z<int16_t>,  //
+        muc_gid_to_center_z<uint32_t>, //
+        muc_gid_to_center_z<int32_t>,  //
+        muc_gid_to_center_z<uint64_t>, //
+        muc_gid_to_center_z<int64_t>>  //
+        ( d, "muc_gid_to_center_z" );
+
+    decl_ufunc_11<                  //
+        muc_gid_to_dir_x<uint16_t>, //
+        muc_gid_to_dir_x<int16_t>,  //
+        muc_gid_to_dir_x<uint32_t>, //
+        muc_gid_to_dir_x<int32_t>,  //
+        muc_gid_to_dir_x<uint64_t>, //
+        muc_gid_to_dir_x<int64_t>>  //
+        ( d, "muc_gid_to_dir_x" );
+
+    decl_ufunc_11<                  //
+        muc_gid_to_dir_y<uint16_t>, //
+        muc_gid_to_dir_y<int16_t>,  //
+        muc_gid_to_dir_y<uint32_t>, //
+        muc_gid_to_dir_y<int32_t>,  //
+        muc_gid_to_dir_y<uint64_t>, //
+        muc_gid_to_dir_y<int64_t>>  //
+        ( d, "muc_gid_to_dir_y" );
+
+    decl_ufunc_11<                  //
+        muc_gid_to_dir_z<uint16_t>, //
+        muc_gid_to_dir_z<int16_t>,  //
+        muc_gid_to_dir_z<uint32_t>, //
+        muc_gid_to_dir_z<int32_t>,  //
+        muc_gid_to_dir_z<uint64_t>, //
+        muc_gid_to_dir_z<int64_t>>  //
+        ( d, "muc_gid_to_dir_z" );
+
+    decl_ufunc_11<                   //
+        muc_gid_to_length<uint16_t>, //
+        muc_gid_to_length<int16_t>,  //
+        muc_gid_to_length<uint32_t>, //
+        muc_gid_to_length<int32_t>,  //
+        muc_gid_to_length<uint64_t>, //
+        muc_gid_to_length<int64_t>>  //
+        ( d, "muc_gid_to_length" );
+}
@@ -0,0 +1,365 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+#include "events.hh"
+#include "mod.hh"
+#include "ufunc.hh"
+
+// ===========================================================================
+// Segmented reductions
+//
+// Reduce the values of each event, optionally grouped by an int64 key in
+// [0, n_keys), into row `i` of an (n_events, n_keys) output. Hits with keys out of
+// range are skipped, NaN values are skipped by min/max/argmin/argmax.
+// ===========================================================================
+enum class ReduceOp { SUM, MIN, MAX, ARGMIN, ARGMAX, COUNT };
+
+template <ReduceOp Op>
+using reduce_out_t = std::conditional_t<Op == ReduceOp::SUM || Op == ReduceOp::MIN ||
+                                            Op == ReduceOp::MAX,
+                                        double, int64_t>;
+
+template <ReduceOp Op>
+static inline bool is_better( double v, double best ) {
+    if constexpr ( Op == ReduceOp::MIN || Op == ReduceOp::ARGMIN ) return v < best;
+    else return v > best;
+}
+
+template <ReduceOp Op>
+void reduce_segments( const int64_t* offsets, const double* values, const int64_t* keys,
+                      int64_t n_keys, int64_t start, int64_t stop, reduce_out_t<Op>* out ) {
+    constexpr double NaN  = std::numeric_limits<double>::quiet_NaN();
+    constexpr bool is_arg = Op == ReduceOp::ARGMIN || Op == ReduceOp::ARGMAX;
+
+    // best value of each key of the current event, for argmin/argmax
+    std::vector<double> best( is_arg ? n_keys : 0 );
+
+    for ( int64_t i = start; i < stop; ++i )
+    {
+        auto row      = out + i * n_keys;
+        int64_t begin = offsets[i];
+
+        if constexpr ( Op == ReduceOp::SUM ) std::fill( row, row + n_keys, 0.0 );
+        else if constexpr ( Op == ReduceOp::COUNT ) std::fill( row, row + n_keys, 0 );
+        else if constexpr ( is_arg )
+        {
+            std::fill( row, row + n_keys, -1 );
+            std::fill( best.begin(), best.end(), NaN );
+        }
+        else std::fill( row, row + n_keys, NaN );
+
+        for ( int64_t h = begin; h < offsets[i + 1]; ++h )
+        {
+            int64_t k = keys ? keys[h] : 0;
+            if ( k < 0 || k >= n_keys ) continue;
+
+            if constexpr ( Op == ReduceOp::COUNT ) ++row[k];
+            else if constexpr ( Op == ReduceOp::SUM ) row[k] += values[h];
+            else
+            {
+                double v = values[h];
+                if ( std::isnan( v ) ) continue;
+
+                if constexpr ( is_arg )
+                {
+                    if ( row[k] < 0 || is_better<Op>( v, best[k] ) )
+                    {
+                        best[k] = v;
+                        row[k]  = h - begin;
+                    }
+                }
+                else if ( std::isnan( row[k] ) || is_better<Op>( v, row[k] ) ) row[k] = v;
+            }
+        }
+    }
+}
+
+template <ReduceOp Op>
+static void run_reduce( const int64_t* offsets, const double* values, const int64_t* keys,
+                        int64_t n_keys, int64_t n_events, int64_t n_hits, void* out ) {
+    auto pout = static_cast<reduce_out_t<Op>*>( out );
+    auto run  = [=]( int64_t start, int64_t stop ) {
+        reduce_segments<Op>( offsets, values, keys, n_keys, start, stop, pout );
+    };
+
+    // the work is proportional to the number of hits, but is split by events
+    auto& pool = ThreadPool::instance();
+    if ( pool.should_split( n_hits ) ) pool.parallel_for( n_events, run );
+    else run( 0, n_events );
+}
+
+// ===========================================================================
+// Per-channel histograms
+//
+// Count the hits of each channel (gid) into `occupancy`, and with `hist`, fill the
+// values of the hits into the (n_channels, n_bins + 2) histograms of the channels,
+// whose first and last bins are the underflow and overflow. The last bin includes
+// `hi`, NaN values are not filled. Returns the number of gids out of range.
+// ===========================================================================
+template <bool HasHist>
+int64_t fill_channel_hist( const int64_t* gid, const double* value, int64_t start,
+                           int64_t stop, int64_t n_channels, int64_t n_bins, double lo,
+                           double hi, int64_t* occupancy, int64_t* hist ) {
+    const double scale = n_bins / ( hi - lo );
+    int64_t n_invalid  = 0;
+
+    for ( int64_t h = start; h < stop; ++h )
+    {
+        int64_t g = gid[h];
+        if ( g < 0 || g >= n_channels )
+        {
+            ++n_invalid;
+            continue;
+        }
+        ++occupancy[g];
+
+        if constexpr ( HasHist )
+        {
+            double v = value[h];
+            if ( std::isnan( v ) ) continue;
+
+            int64_t b;
+            if ( v < lo ) b = 0;
+            else if ( v > hi ) b = n_bins + 1;
+            else b = 1 + std::min( static_cast<int64_t>( ( v - lo ) * scale ), n_bins - 1 );
+            ++hist[g * ( n_bins + 2 ) + b];
+        }
+    }
+    return n_invalid;
+}
+
+template <bool HasHist>
+static int64_t run_channel_hist( const int64_t* gid, const double* value, int64_t n,
+                                 int64_t n_channels, int64_t n_bins, double lo, double hi,
+                                 int64_t* occupancy, int64_t* hist ) {
+    int64_t n_hist = HasHist ? n_channels * ( n_bins + 2 ) : 0;
+
+    // private bins of each thread are only worth it when there are more hits than bins
+    auto& pool = ThreadPool::instance();
+    if ( !pool.should_split( n ) || n < n_channels + n_hist )
+        return fill_channel_hist<HasHist>( gid, value, 0, n, n_channels, n_bins, lo, hi,
+                                           occupancy, hist );
+
+    std::mutex merge_mutex;
+    int64_t n_invalid = 0;
+    pool.parallel_for( n, [&]( int64_t start, int64_t stop ) {
+        std::vector<int64_t> bins( n_channels + n_hist, 0 );
+        int64_t chunk_invalid = fill_channel_hist<HasHist>(
+            gid, value, start, stop, n_channels, n_bins, lo, hi, bins.data(),
+            bins.data() + n_channels );
+
+        std::lock_guard<std::mutex> lock( merge_mutex );
+        n_invalid += chunk_invalid;
+        for ( int64_t i = 0; i < n_channels; ++i ) occupancy[i] += bins[i];
+        for ( int64_t i = 0; i < n_hist; ++i ) hist[i] += bins[n_channels + i];
+    } );
+    return n_invalid;
+}
+
+// ===========================================================================
+// Python interface
+// ===========================================================================
+using reduce_fn = void ( * )( const int64_t*, const double*, const int64_t*, int64_t, int64_t,
+                              int64_t, void* );
+
+struct ReduceKernel {
+    const char* name;
+    reduce_fn fn;
+    bool needs_values;
+    int out_type;
+};
+
+constexpr ReduceKernel REDUCE_KERNELS[] = {
+    { "sum", run_reduce<ReduceOp::SUM>, true, NPY_DOUBLE },
+    { "min", run_reduce<ReduceOp::MIN>, true, NPY_DOUBLE },
+    { "max", run_reduce<ReduceOp::MAX>, true, NPY_DOUBLE },
+    { "argmin", run_reduce<ReduceOp::ARGMIN>, true, NPY_INT64 },
+    { "argmax", run_reduce<ReduceOp::ARGMAX>, true, NPY_INT64 },
+    { "count", run_reduce<ReduceOp::COUNT>, false, NPY_INT64 },
+};
+
+// Check that `arr` is a contiguous 1D array of `type_num` with `n` elements
+static bool check_flat( PyObject* arr, int type_num, npy_intp n, const char* msg ) {
+    auto a = (PyArrayObject*)arr;
+    if ( !PyArray_Check( arr ) || PyArray_TYPE( a ) != type_num || PyArray_NDIM( a ) != 1 ||
+         !PyArray_IS_C_CONTIGUOUS( a ) || PyArray_SIZE( a ) != n )
+    {
+        PyErr_SetString( PyExc_ValueError, msg );
+        return false;
+    }
+    return true;
+}
+
+PyObject* _reduce_events( PyObject* self, PyObject* args ) {
+    PyArrayObject* offsets = nullptr;
+    PyObject *values       = nullptr, *keys = nullptr;
+    long long n_keys       = 0;
+    const char* op         = nullptr;
+
+    if ( !PyArg_ParseTuple( args, "O!OOLs",          //
+                            &PyArray_Type, &offsets, //
+                            &values, &keys,          //
+                            &n_keys, &op ) )         //
+        return nullptr;
+
+    const ReduceKernel* kernel = nullptr;
+    for ( auto& k : REDUCE_KERNELS )
+        if ( std::strcmp( op, k.name ) == 0 ) kernel = &k;
+
+    if ( !kernel )
+    {
+        PyErr_Format( PyExc_ValueError,
+                      "Unknown reduction '%s', must be one of sum, min, max, argmin, "
+                      "argmax and count",
+                      op );
+        return nullptr;
+    }
+
+    bool has_values = values != Py_None;
+    bool has_keys   = keys != Py_None;
+    if ( kernel->needs_values && !has_values )
+    {
+        PyErr_Format( PyExc_ValueError, "values are required by %s", op );
+        return nullptr;
+    }
+
+    if ( has_keys ? n_keys < 1 : n_keys != 1 )
+    {
+        PyErr_SetString( PyExc_ValueError, "n_keys must be positive, and 1 without keys" );
+        return nullptr;
+    }
+
+    if ( ( has_values && !PyArray_Check( values ) ) || ( has_keys && !PyArray_Check( keys ) ) )
+    {
+        PyErr_SetString( PyExc_TypeError, "values and keys must be numpy arrays or None" );
+        return nullptr;
+    }
+
+    // without values and keys, the number of hits is the last offset
+    npy_intp n_hits = -1;
+    if ( has_values ) n_hits = PyArray_SIZE( (PyArrayObject*)values );
+    else if ( has_keys ) n_hits = PyArray_SIZE( (PyArrayObject*)keys );
+    else if ( PyArray_TYPE( offsets ) == NPY_INT64 && PyArray_NDIM( offsets ) == 1 &&
+              PyArray_SIZE( offsets ) > 0 )
+        n_hits = *static_cast<const int64_t*>(
+            PyArray_GETPTR1( offsets, PyArray_SIZE( offsets ) - 1 ) );
+
+    if ( !check_offsets( offsets, n_hits ) ||
+         ( has_values && !check_flat( values, NPY_DOUBLE, n_hits,
+                                      "values must be a contiguous 1D float64 array" ) ) ||
+         ( has_keys && !check_flat( keys, NPY_INT64, n_hits,
+                                    "keys must be a contiguous 1D int64 array" ) ) )
+        return nullptr;
+
+    npy_intp n_events = PyArray_SIZE( offsets ) - 1;
+    npy_intp dims[2]  = { n_events, static_cast<npy_intp>( n_keys ) };
+    PyObject* out     = PyArray_SimpleNew( has_keys ? 2 : 1, dims, kernel->out_type );
+    if ( !out ) return nullptr;
+
+    auto poffsets = static_cast<const int64_t*>( PyArray_DATA( offsets ) );
+    auto pvalues  = has_values ? (const double*)PyArray_DATA( (PyArrayObject*)values )
+                               : nullptr;
+    auto pkeys    = has_keys ? (const int64_t*)PyArray_DATA( (PyArrayObject*)keys ) : nullptr;
+    auto pout     = PyArray_DATA( (PyArrayObject*)out );
+
+    Py_BEGIN_ALLOW_THREADS;
+    kernel->fn( poffsets, pvalues, pkeys, n_keys, n_events, n_hits, pout );
+    Py_END_ALLOW_THREADS;
+
+    return out;
+}
+
+PyObject* _fill_channel_hist( PyObject* self, PyObject* args ) {
+    PyObject *occupancy = nullptr, *hist = nullptr, *gid = nullptr, *value = nullptr;
+    double lo = 0, hi = 0;
+
+    if ( !PyArg_ParseTuple( args, "OOOOdd",            //
+                            &occupancy, &hist,         //
+                            &gid, &value, &lo, &hi ) ) //
+        return nullptr;
+
+    if ( !PyArray_Check( occupancy ) || !PyArray_Check( gid ) ||
+         ( hist != Py_None && !PyArray_Check( hist ) ) ||
+         ( value != Py_None && !PyArray_Check( value ) ) )
+    {
+        PyErr_SetString( PyExc_TypeError, "Inputs must be numpy arrays or None" );
+        return nullptr;
+    }
+
+    bool has_hist = hist != Py_None;
+    if ( has_hist != ( value != Py_None ) )
+    {
+        PyErr_SetString( PyExc_ValueError, "hist and value must be given together" );
+        return nullptr;
+    }
+
+    auto occupancy_arr  = (PyArrayObject*)occupancy;
+    auto hist_arr       = (PyArrayObject*)hist;
+    npy_intp n_channels = PyArray_SIZE( occupancy_arr );
+    npy_intp n          = PyArray_SIZE( (PyArrayObject*)gid );
+    if ( !check_flat( occupancy, NPY_INT64, n_channels,
+                      "occupancy must be a writeable contiguous 1D int64 array" ) ||
+         !check_flat( gid, NPY_INT64, n, "gid must be a contiguous 1D int64 array" ) )
+        return nullptr;
+
+    if ( !PyArray_ISWRITEABLE( occupancy_arr ) )
+    {
+        PyErr_SetString( PyExc_ValueError,
+                         "occupancy must be a writeable contiguous 1D int64 array" );
+        return nullptr;
+    }
+
+    npy_intp n_bins = 0;
+    if ( has_hist )
+    {
+        if ( PyArray_TYPE( hist_arr ) != NPY_INT64 || PyArray_NDIM( hist_arr ) != 2 ||
+             !PyArray_IS_C_CONTIGUOUS( hist_arr ) || !PyArray_ISWRITEABLE( hist_arr ) ||
+             PyArray_DIM( hist_arr, 0 ) != n_channels || PyArray_DIM( hist_arr, 1 ) < 3 )
+        {
+            PyErr_SetString( PyExc_ValueError,
+                             "hist must be a writeable contiguous int64 array in shape "
+                             "(n_channels, n_bins + 2)" );
+            return nullptr;
+        }
+
+        if ( !check_flat( value, NPY_DOUBLE, n,
+                          "value must be a contiguous 1D float64 array of the size of gid" ) )
+            return nullptr;
+
+        if ( !( lo < hi ) || !std::isfinite( lo ) || !std::isfinite( hi ) )
+        {
+            PyErr_SetString( PyExc_ValueError, "Histogram range must be finite and lo < hi" );
+            return nullptr;
+        }
+        n_bins = PyArray_DIM( hist_arr, 1 ) - 2;
+    }
+
+    auto pgid         = static_cast<const int64_t*>( PyArray_DATA( (PyArrayObject*)gid ) );
+    auto poccupancy   = static_cast<int64_t*>( PyArray_DATA( occupancy_arr ) );
+    int64_t n_invalid = 0;
+
+    Py_BEGIN_ALLOW_THREADS;
+    if ( has_hist )
+    {
+        auto pvalue = static_cast<const double*>( PyArray_DATA( (PyArrayObject*)value ) );
+        auto phist  = static_cast<int64_t*>( PyArray_DATA( hist_arr ) );
+        n_invalid   = run_channel_hist<true>( pgid, pvalue, n, n_channels, n_bins, lo, hi,
+                                              poccupancy, phist );
+    }
+    else
+        n_invalid = run_channel_hist<false>( pgid, nullptr, n, n_channels, 0, 0.0, 1.0,
+                                             poccupancy, nullptr );
+    Py_END_ALLOW_THREADS;
+
+    return PyLong_FromLongLong( n_invalid );
+}
+
+void declare_reduce( PyObject* d ) {
+    // no ufuncs, only the numpy C API of this translation unit is initialized
+    if ( _import_array() < 0 ) return;
+}
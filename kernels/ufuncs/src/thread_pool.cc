@@ -0,0 +1,180 @@
+#include <algorithm>
+#include <system_error>
+
+#ifndef _WIN32
+#    include <unistd.h>
+#endif
+
+#include "mod.hh"
+#include "thread_pool.hh"
+
+namespace {
+    int64_t current_pid() {
+#ifdef _WIN32
+        return 0;
+#else
+        return static_cast<int64_t>( getpid() );
+#endif
+    }
+
+    // Chunks are aligned to 64 elements so that threads do not share cache lines
+    // of the output arrays
+    constexpr int64_t CHUNK_ALIGN = 64;
+} // namespace
+
+ThreadPool& ThreadPool::instance() {
+    // Never destroyed: joining threads in static destructors may deadlock at
+    // interpreter shutdown, idle workers are simply discarded at process exit.
+    static ThreadPool* pool = new ThreadPool();
+    return *pool;
+}
+
+void ThreadPool::set_num_threads( size_t n ) {
+    if ( n == 0 ) n = std::max( 1u, std::thread::hardware_concurrency() );
+    m_num_threads = n;
+    resize_workers( n - 1 );
+}
+
+void ThreadPool::resize_workers( size_t n_workers ) {
+    std::lock_guard<std::mutex> resize_lock( m_resize_mutex );
+
+    std::vector<std::thread> old_workers;
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+
+        // worker threads do not survive fork(), the child process starts a new pool.
+        // The stale handles are leaked since they can be neither joined nor detached.
+        if ( m_pid != current_pid() )
+        {
+            new std::vector<std::thread>( std::move( m_workers ) );
+            m_workers.clear();
+            m_tasks.clear();
+            m_pid = current_pid();
+        }
+
+        if ( m_workers.size() == n_workers ) return;
+
+        m_stop = true;
+        old_workers.swap( m_workers );
+    }
+
+    m_cv.notify_all();
+    for ( auto& t : old_workers ) t.join();
+
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_stop = false;
+    for ( size_t i = 0; i < n_workers; ++i )
+        m_workers.emplace_back( [this] { worker_loop(); } );
+}
+
+void ThreadPool::worker_loop() {
+    while ( true )
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock( m_mutex );
+            m_cv.wait( lock, [this] { return m_stop || !m_tasks.empty(); } );
+            if ( m_stop && m_tasks.empty() ) return;
+
+            task = std::move( m_tasks.front() );
+            m_tasks.pop_front();
+        }
+        task();
+    }
+}
+
+void ThreadPool::parallel_for( int64_t n, const std::function<void( int64_t, int64_t )>& fn ) {
+    if ( m_pid != current_pid() ) resize_workers( m_num_threads - 1 );
+
+    int64_t n_chunks   = static_cast<int64_t>( m_num_threads );
+    int64_t chunk_size = ( n + n_chunks - 1 ) / n_chunks;
+    chunk_size         = ( chunk_size + CHUNK_ALIGN - 1 ) / CHUNK_ALIGN * CHUNK_ALIGN;
+    n_chunks           = ( n + chunk_size - 1 ) / chunk_size;
+
+    std::mutex done_mutex;
+    std::condition_variable done_cv;
+    int64_t n_pending = n_chunks - 1;
+
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        for ( int64_t i = 1; i < n_chunks; ++i )
+        {
+            int64_t start = i * chunk_size;
+            int64_t stop  = std::min( n, start + chunk_size );
+            m_tasks.emplace_back( [&, start, stop] {
+                fn( start, stop );
+
+                std::lock_guard<std::mutex> done_lock( done_mutex );
+                if ( --n_pending == 0 ) done_cv.notify_one();
+            } );
+        }
+    }
+    m_cv.notify_all();
+
+    fn( 0, std::min( n, chunk_size ) );
+
+    // help with the queued chunks instead of idling, this also guarantees progress
+    // while the workers are being resized
+    while ( true )
+    {
+        std::function<void()> task;
+        {
+            std::lock_guard<std::mutex> lock( m_mutex );
+            if ( m_tasks.empty() ) break;
+            task = std::move( m_tasks.front() );
+            m_tasks.pop_front();
+        }
+        task();
+    }
+
+    std::unique_lock<std::mutex> done_lock( done_mutex );
+    done_cv.wait( done_lock, [&] { return n_pending == 0; } );
+}
+
+// ===========================================================================
+// Python interface
+// ===========================================================================
+PyObject* _set_num_threads( PyObject* self, PyObject* args ) {
+    Py_ssize_t n = 0;
+    if ( !PyArg_ParseTuple( args, "n", &n ) ) return nullptr;
+    if ( n < 0 )
+    {
+        PyErr_SetString( PyExc_ValueError, "Number of threads must be non-negative" );
+        return nullptr;
+    }
+
+    bool ok = true;
+    Py_BEGIN_ALLOW_THREADS;
+    try
+    { ThreadPool::instance().set_num_threads( static_cast<size_t>( n ) ); }
+    catch ( const std::system_error& ) { ok = false; }
+    Py_END_ALLOW_THREADS;
+
+    if ( !ok )
+    {
+        PyErr_SetString( PyExc_RuntimeError, "Failed to start worker threads" );
+        return nullptr;
+    }
+    Py_RETURN_NONE;
+}
+
+PyObject* _get_num_threads( PyObject* self, PyObject* args ) {
+    return PyLong_FromSize_t( ThreadPool::instance().num_threads() );
+}
+
+PyObject* _set_parallel_threshold( PyObject* self, PyObject* args ) {
+    long long n = 0;
+    if ( !PyArg_ParseTuple( args, "L", &n ) ) return nullptr;
+    if ( n < 0 )
+    {
+        PyErr_SetString( PyExc_ValueError, "Parallel threshold must be non-negative" );
+        return nullptr;
+    }
+
+    ThreadPool::instance().set_threshold( static_cast<int64_t>( n ) );
+    Py_RETURN_NONE;
+}
+
+PyObject* _get_parallel_threshold( PyObject* self, PyObject* args ) {
+    return PyLong_FromLongLong( ThreadPool::instance().threshold() );
+}
@@ -1,6 +1,15 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
 #include <numeric>
 #include <tuple>
+#include <vector>
 
+#include "events.hh"
+#include "digi.hh"
+#include "geom.hh"
+#include "gid.hh"
 #include "mod.hh"
 #include "ufunc.hh"
 
@@ -52,6 +61,42 @@ inline void get_tof_gid( T* part, T* layer_or_module, T* phi_or_strip, T* out )
     *out += *phi_or_strip;
 }
 
+// digi ID -> gid: rows are bits 5-15, i.e. the MRPC part, endcap and module, or the
+// scintillator part, layer and phi / 16. The MRPC strip or phi % 16 is the local index.
+constexpr DigiLayout TOF_DIGI_LAYOUT = {
+    DIGI_TOF_FLAG, DIGI_TOF_PART_MASK | DIGI_TOF_MRPC_ENDCAP_MASK | DIGI_TOF_MRPC_MODULE_MASK,
+    DIGI_TOF_MRPC_MODULE_OFFSET, DIGI_TOF_MRPC_STRIP_MASK, DIGI_TOF_MRPC_STRIP_OFFSET };
+
+constexpr auto _tof_digi_id = []( size_t gid ) -> uint32_t {
+    uint32_t part = _part[gid];
+    if ( part < 3 )
+        return ( part << DIGI_TOF_PART_OFFSET ) |
+               ( _layer_or_module[gid] << DIGI_TOF_SCINT_LAYER_OFFSET ) |
+               ( _phi_or_strip[gid] << DIGI_TOF_SCINT_PHI_OFFSET );
+    return ( 3 << DIGI_TOF_PART_OFFSET ) | ( ( part - 3 ) << DIGI_TOF_MRPC_ENDCAP_OFFSET ) |
+           ( _layer_or_module[gid] << DIGI_TOF_MRPC_MODULE_OFFSET ) |
+           ( _phi_or_strip[gid] << DIGI_TOF_MRPC_STRIP_OFFSET );
+};
+
+consteval auto _init_tof_digi_rows() {
+    DigiRows<TOF_DIGI_LAYOUT> rows{};
+    for ( size_t gid = 0; gid < N_STRIPS; ++gid )
+        add_digi_row<TOF_DIGI_LAYOUT>( rows, _tof_digi_id( gid ), gid );
+    return rows;
+}
+
+constexpr auto _tof_digi_rows = _init_tof_digi_rows();
+static_assert( check_digi_rows<TOF_DIGI_LAYOUT>( _tof_digi_rows, N_STRIPS, _tof_digi_id ) );
+
+template <typename T>
+inline void tof_id_to_gid( T* tof_id, int64_t* gid ) noexcept {
+    *gid = digi_row_gid<TOF_DIGI_LAYOUT>( _tof_digi_rows, *tof_id );
+}
+
+int64_t tof_digi_gid( uint64_t digi_id ) noexcept {
+    return digi_row_gid<TOF_DIGI_LAYOUT>( _tof_digi_rows, digi_id );
+}
+
 template <typename T>
 inline void tof_gid_to_part( T* gid, T* part ) noexcept {
     *part = _part[*gid];
@@ -67,6 +112,13 @@ inline void tof_gid_to_phi_or_strip( T* gid, T* phi_or_strip ) noexcept {
     *phi_or_strip = _phi_or_strip[*gid];
 }
 
+template <typename T>
+inline void parse_tof_gid( T* gid, T* part, T* layer_or_module, T* phi_or_strip ) noexcept {
+    *part            = _part[*gid];
+    *layer_or_module = _layer_or_module[*gid];
+    *phi_or_strip    = _phi_or_strip[*gid];
+}
+
 /* ------ Hit Status ------*/
 
 template <typename T>
@@ -134,6 +186,478 @@ inline void tof_hit_status_to_is_mrpc( T* status, bool* out ) noexcept {
     *out = ( ( *status & 0x01000000 ) >> 24 ) > 0;
 }
 
+/* ------ East/west pairing ------*/
+
+constexpr int64_t TOF_EAST = 0;
+constexpr int64_t TOF_WEST = 1;
+
+// Output buffers of `pair_tof_ends`, one entry per counter hit
+struct TofCounterHits {
+    int64_t* gid;
+    double *time, *z, *time_east, *time_west, *adc_east, *adc_west;
+    bool* is_overflow;
+};
+
+/*
+ * Pair the east and west readouts of the counters hit in one event. Digis are sorted by
+ * gid, and the earliest digi of each end is used. The time of each end is
+ * tdc * tdc_to_ns - time_walk / sqrt(adc), the time of the counter is the mean of both
+ * ends (or the time of the only end), and the hit position along the counter is
+ * z = v_eff * (t_west - t_east) / 2, positive towards the east end.
+ *
+ * When `out` is null, only the number of counter hits is returned.
+ */
+int64_t pair_tof_ends( const int64_t* gid, const int64_t* end, const double* tdc,
+                       const double* adc, const bool* overflow, int64_t n,
+                       const double* tdc_to_ns, const double* time_walk, const double* v_eff,
+                       const TofCounterHits* out, int64_t out_start,
+                       std::vector<int64_t>& order ) {
+    order.clear();
+    for ( int64_t i = 0; i < n; ++i )
+        if ( gid[i] >= 0 && gid[i] < static_cast<int64_t>( N_STRIPS ) &&
+             ( end[i] == TOF_EAST || end[i] == TOF_WEST ) )
+            order.push_back( i );
+
+    std::stable_sort( order.begin(), order.end(),
+                      [&]( int64_t a, int64_t b ) { return gid[a] < gid[b]; } );
+
+    constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+    int64_t n_counters   = 0;
+    for ( size_t k = 0; k < order.size(); )
+    {
+        int64_t cur_gid = gid[order[k]];
+        auto part       = _part[cur_gid];
+
+        double time[2]      = { nan, nan };
+        double charge[2]    = { nan, nan };
+        bool is_overflow[2] = { false, false };
+        for ( ; k < order.size() && gid[order[k]] == cur_gid; ++k )
+        {
+            int64_t i = order[k];
+            double t  = tdc[i] * tdc_to_ns[part];
+            if ( adc[i] > 0 ) t -= time_walk[part] / std::sqrt( adc[i] );
+
+            if ( std::isnan( time[end[i]] ) || t < time[end[i]] )
+            {
+                time[end[i]]        = t;
+                charge[end[i]]      = adc[i];
+                is_overflow[end[i]] = overflow[i];
+            }
+        }
+
+        if ( out )
+        {
+            int64_t j           = out_start + n_counters;
+            out->gid[j]         = cur_gid;
+            out->time_east[j]   = time[TOF_EAST];
+            out->time_west[j]   = time[TOF_WEST];
+            out->adc_east[j]    = charge[TOF_EAST];
+            out->adc_west[j]    = charge[TOF_WEST];
+            out->is_overflow[j] = is_overflow[TOF_EAST] || is_overflow[TOF_WEST];
+
+            if ( !std::isnan( time[TOF_EAST] ) && !std::isnan( time[TOF_WEST] ) )
+            {
+                out->time[j] = 0.5 * ( time[TOF_EAST] + time[TOF_WEST] );
+                out->z[j]    = 0.5 * v_eff[part] * ( time[TOF_WEST] - time[TOF_EAST] );
+            }
+            else
+            {
+                out->time[j] = std::isnan( time[TOF_EAST] ) ? time[TOF_WEST] : time[TOF_EAST];
+                out->z[j]    = nan;
+            }
+        }
+        n_counters++;
+    }
+
+    return n_counters;
+}
+
+PyObject* _tof_pair_ends( PyObject* self, PyObject* args ) {
+    PyArrayObject *offsets = nullptr, *gid = nullptr, *end = nullptr, *tdc = nullptr,
+                  *adc = nullptr, *overflow = nullptr, *params = nullptr;
+
+    if ( !PyArg_ParseTuple( args, "O!O!O!O!O!O!O!",  //
+                            &PyArray_Type, &offsets,  //
+                            &PyArray_Type, &gid,      //
+                            &PyArray_Type, &end,      //
+                            &PyArray_Type, &tdc,      //
+                            &PyArray_Type, &adc,      //
+                            &PyArray_Type, &overflow, //
+                            &PyArray_Type, &params    //
+                            ) )                       //
+        return nullptr;
+
+    npy_intp n_digis = PyArray_SIZE( gid );
+    for ( auto [arr, type] : { std::pair{ gid, NPY_INT64 }, std::pair{ end, NPY_INT64 },
+                               std::pair{ tdc, NPY_DOUBLE }, std::pair{ adc, NPY_DOUBLE },
+                               std::pair{ overflow, NPY_BOOL } } )
+    {
+        if ( PyArray_TYPE( arr ) != type || PyArray_NDIM( arr ) != 1 ||
+             !PyArray_IS_C_CONTIGUOUS( arr ) || PyArray_SIZE( arr ) != n_digis )
+        {
+            PyErr_SetString( PyExc_ValueError,
+                             "gid, end, tdc, adc and overflow must be contiguous 1D int64, "
+                             "int64, float64, float64 and bool arrays of the same size" );
+            return nullptr;
+        }
+    }
+
+    if ( PyArray_TYPE( params ) != NPY_DOUBLE || PyArray_NDIM( params ) != 2 ||
+         PyArray_DIM( params, 0 ) != 3 || PyArray_DIM( params, 1 ) != N_PARTS ||
+         !PyArray_IS_C_CONTIGUOUS( params ) )
+    {
+        PyErr_SetString( PyExc_ValueError,
+                         "params must be a contiguous (3, 5) float64 array" );
+        return nullptr;
+    }
+
+    if ( !check_offsets( offsets, n_digis ) ) return nullptr;
+
+    npy_intp n_events        = PyArray_SIZE( offsets ) - 1;
+    npy_intp offsets_dims[1] = { n_events + 1 };
+    PyObject* out_offsets    = PyArray_ZEROS( 1, offsets_dims, NPY_INT64, 0 );
+    if ( !out_offsets ) return nullptr;
+
+    auto poffsets     = static_cast<const int64_t*>( PyArray_DATA( offsets ) );
+    auto pgid         = static_cast<const int64_t*>( PyArray_DATA( gid ) );
+    auto pend         = static_cast<const int64_t*>( PyArray_DATA( end ) );
+    auto ptdc         = static_cast<const double*>( PyArray_DATA( tdc ) );
+    auto padc         = static_cast<const double*>( PyArray_DATA( adc ) );
+    auto poverflow    = static_cast<const bool*>( PyArray_DATA( overflow ) );
+    auto pparams      = static_cast<const double*>( PyArray_DATA( params ) );
+    auto pout_offsets = static_cast<int64_t*>( PyArray_DATA( (PyArrayObject*)out_offsets ) );
+
+    // rows of params: tdc_to_ns, time_walk and v_eff of each part
+    const double* tdc_to_ns = pparams;
+    const double* time_walk = pparams + N_PARTS;
+    const double* v_eff     = pparams + 2 * N_PARTS;
+
+    // first pass: number of counter hits of each event, second pass: fill them
+    const TofCounterHits* out = nullptr;
+    auto run                  = [&]( int64_t start, int64_t stop ) {
+        std::vector<int64_t> order;
+        for ( int64_t i = start; i < stop; ++i )
+        {
+            int64_t b = poffsets[i];
+            int64_t n = pair_tof_ends( pgid + b, pend + b, ptdc + b, padc + b, poverflow + b,
+                                       poffsets[i + 1] - b, tdc_to_ns, time_walk, v_eff, out,
+                                       pout_offsets[i], order );
+            if ( !out ) pout_offsets[i + 1] = n;
+        }
+    };
+
+    Py_BEGIN_ALLOW_THREADS;
+    auto& pool = ThreadPool::instance();
+    if ( pool.should_split( n_events ) ) pool.parallel_for( n_events, run );
+    else run( 0, n_events );
+    for ( npy_intp i = 0; i < n_events; ++i ) pout_offsets[i + 1] += pout_offsets[i];
+    Py_END_ALLOW_THREADS;
+
+    npy_intp n_hits         = pout_offsets[n_events];
+    PyObject* out_gid       = PyArray_SimpleNew( 1, &n_hits, NPY_INT64 );
+    PyObject* out_time      = PyArray_SimpleNew( 1, &n_hits, NPY_DOUBLE );
+    PyObject* out_z         = PyArray_SimpleNew( 1, &n_hits, NPY_DOUBLE );
+    PyObject* out_time_east = PyArray_SimpleNew( 1, &n_hits, NPY_DOUBLE );
+    PyObject* out_time_west = PyArray_SimpleNew( 1, &n_hits, NPY_DOUBLE );
+    PyObject* out_adc_east  = PyArray_SimpleNew( 1, &n_hits, NPY_DOUBLE );
+    PyObject* out_adc_west  = PyArray_SimpleNew( 1, &n_hits, NPY_DOUBLE );
+    PyObject* out_overflow  = PyArray_SimpleNew( 1, &n_hits, NPY_BOOL );
+
+    auto outs = { out_offsets,   out_gid,       out_time,     out_z,       out_time_east,
+                  out_time_west, out_adc_east, out_adc_west, out_overflow };
+    for ( auto o : outs )
+    {
+        if ( o ) continue;
+        for ( auto p : outs ) Py_XDECREF( p );
+        return nullptr;
+    }
+
+    auto f64 = []( PyObject* arr ) {
+        return static_cast<double*>( PyArray_DATA( (PyArrayObject*)arr ) );
+    };
+    TofCounterHits hits{
+        static_cast<int64_t*>( PyArray_DATA( (PyArrayObject*)out_gid ) ),
+        f64( out_time ),
+        f64( out_z ),
+        f64( out_time_east ),
+        f64( out_time_west ),
+        f64( out_adc_east ),
+        f64( out_adc_west ),
+        static_cast<bool*>( PyArray_DATA( (PyArrayObject*)out_overflow ) ),
+    };
+    out = &hits;
+
+    Py_BEGIN_ALLOW_THREADS;
+    auto& pool = ThreadPool::instance();
+    if ( pool.should_split( n_events ) ) pool.parallel_for( n_events, run );
+    else run( 0, n_events );
+    Py_END_ALLOW_THREADS;
+
+    return Py_BuildValue( "NNNNNNNNN", out_offsets, out_gid, out_time, out_z, out_time_east,
+                          out_time_west, out_adc_east, out_adc_west, out_overflow );
+}
+
+/* ------ Counter geometry ------*/
+
+/*
+ * Geometry arrays. Each counter is described by its center and its extent in cylindrical
+ * coordinates: [phi_min, phi_max] (wrapping around 2 pi when phi_min > phi_max), [z_min,
+ * z_max] and [r_min, r_max]. The TOF geometry is not shipped, so they stay `nan` until
+ * `_init_tof_geom` is called.
+ */
+std::array<double, N_STRIPS> _counter_center_x = _nan_array<N_STRIPS>();
+std::array<double, N_STRIPS> _counter_center_y = _nan_array<N_STRIPS>();
+std::array<double, N_STRIPS> _counter_center_z = _nan_array<N_STRIPS>();
+std::array<double, N_STRIPS> _counter_phi_min  = _nan_array<N_STRIPS>();
+std::array<double, N_STRIPS> _counter_phi_max  = _nan_array<N_STRIPS>();
+std::array<double, N_STRIPS> _counter_z_min    = _nan_array<N_STRIPS>();
+std::array<double, N_STRIPS> _counter_z_max    = _nan_array<N_STRIPS>();
+std::array<double, N_STRIPS> _counter_r_min    = _nan_array<N_STRIPS>();
+std::array<double, N_STRIPS> _counter_r_max    = _nan_array<N_STRIPS>();
+
+/* phi grid over the counters, built in `_init_tof_geom` */
+constexpr int GRID_N_PHI   = 96;
+constexpr double GRID_DPHI = TWO_PI / GRID_N_PHI;
+
+std::array<uint32_t, GRID_N_PHI + 1> _counter_grid_offsets{};
+std::vector<uint16_t> _counter_grid_gids;
+
+inline double wrap_phi( double phi ) noexcept {
+    phi = std::fmod( phi, TWO_PI );
+    return phi < 0 ? phi + TWO_PI : phi;
+}
+
+// Whether `phi` is inside [phi_min - tol, phi_max + tol], wrapping around 2 pi
+inline bool in_phi_range( double phi, double phi_min, double phi_max, double tol ) noexcept {
+    double width = wrap_phi( phi_max - phi_min );
+    double d     = wrap_phi( phi - phi_min );
+    return d <= width + tol || d >= TWO_PI - tol;
+}
+
+void _build_tof_grid() {
+    std::array<uint32_t, GRID_N_PHI + 1> counts{};
+    std::vector<std::pair<uint16_t, uint16_t>> cells; // (cell, gid)
+
+    for ( size_t gid = 0; gid < N_STRIPS; ++gid )
+    {
+        double phi_min = _counter_phi_min[gid], phi_max = _counter_phi_max[gid];
+        if ( !std::isfinite( phi_min ) || !std::isfinite( phi_max ) ) continue;
+
+        int first = static_cast<int>( wrap_phi( phi_min ) / GRID_DPHI );
+        int n     = static_cast<int>( wrap_phi( phi_max - phi_min ) / GRID_DPHI ) + 2;
+        for ( int i = 0; i < std::min( n, GRID_N_PHI ); ++i )
+        {
+            int cell = ( first + i ) % GRID_N_PHI;
+            cells.emplace_back( cell, gid );
+            counts[cell + 1]++;
+        }
+    }
+
+    for ( size_t i = 1; i < counts.size(); ++i ) counts[i] += counts[i - 1];
+    _counter_grid_offsets = counts;
+
+    _counter_grid_gids.assign( cells.size(), 0 );
+    for ( auto [cell, gid] : cells ) _counter_grid_gids[counts[cell]++] = gid;
+}
+
+PyObject* _init_tof_geom( PyObject* self, PyObject* args ) {
+    PyArrayObject *center_x = nullptr, *center_y = nullptr, *center_z = nullptr;
+    PyArrayObject *phi_min = nullptr, *phi_max = nullptr;
+    PyArrayObject *z_min = nullptr, *z_max = nullptr, *r_min = nullptr, *r_max = nullptr;
+
+    if ( !PyArg_ParseTuple( args, "O!O!O!O!O!O!O!O!O!",   //
+                            &PyArray_Type, &center_x, //
+                            &PyArray_Type, &center_y, //
+                            &PyArray_Type, &center_z, //
+                            &PyArray_Type, &phi_min,  //
+                            &PyArray_Type, &phi_max,  //
+                            &PyArray_Type, &z_min,    //
+                            &PyArray_Type, &z_max,    //
+                            &PyArray_Type, &r_min,    //
+                            &PyArray_Type, &r_max     //
+                            ) )                       //
+        return nullptr;
+
+    auto arrays = { std::pair{ center_x, &_counter_center_x },
+                    std::pair{ center_y, &_counter_center_y },
+                    std::pair{ center_z, &_counter_center_z },
+                    std::pair{ phi_min, &_counter_phi_min },
+                    std::pair{ phi_max, &_counter_phi_max },
+                    std::pair{ z_min, &_counter_z_min },
+                    std::pair{ z_max, &_counter_z_max },
+                    std::pair{ r_min, &_counter_r_min },
+                    std::pair{ r_max, &_counter_r_max } };
+
+    for ( auto [arr, dst] : arrays )
+    {
+        if ( PyArray_TYPE( arr ) != NPY_DOUBLE || PyArray_NDIM( arr ) != 1 ||
+             !PyArray_IS_C_CONTIGUOUS( arr ) ||
+             PyArray_SIZE( arr ) != static_cast<npy_intp>( N_STRIPS ) )
+        {
+            PyErr_SetString( PyExc_ValueError,
+                             "TOF geometry arrays must be contiguous 1D float64 arrays with "
+                             "one entry per counter" );
+            return nullptr;
+        }
+    }
+
+    for ( auto [arr, dst] : arrays )
+        memcpy( dst->data(), PyArray_DATA( arr ), dst->size() * sizeof( double ) );
+
+    _build_tof_grid();
+    Py_RETURN_NONE;
+}
+
+template <typename T>
+inline void tof_gid_to_center_x( T* gid, double* out ) noexcept {
+    *out = _counter_center_x[*gid];
+}
+
+template <typename T>
+inline void tof_gid_to_center_y( T* gid, double* out ) noexcept {
+    *out = _counter_center_y[*gid];
+}
+
+template <typename T>
+inline void tof_gid_to_center_z( T* gid, double* out ) noexcept {
+    *out = _counter_center_z[*gid];
+}
+
+template <typename T>
+inline void tof_gid_to_phi_min( T* gid, double* out ) noexcept {
+    *out = _counter_phi_min[*gid];
+}
+
+template <typename T>
+inline void tof_gid_to_phi_max( T* gid, double* out ) noexcept {
+    *out = _counter_phi_max[*gid];
+}
+
+template <typename T>
+inline void tof_gid_to_z_min( T* gid, double* out ) noexcept {
+    *out = _counter_z_min[*gid];
+}
+
+template <typename T>
+inline void tof_gid_to_z_max( T* gid, double* out ) noexcept {
+    *out = _counter_z_max[*gid];
+}
+
+template <typename T>
+inline void tof_gid_to_r_min( T* gid, double* out ) noexcept {
+    *out = _counter_r_min[*gid];
+}
+
+template <typename T>
+inline void tof_gid_to_r_max( T* gid, double* out ) noexcept {
+    *out = _counter_r_max[*gid];
+}
+
+/*
+ * Find the counters whose extent, enlarged by the tolerances, contains (x, y, z). At most
+ * `k` counters are kept, sorted by the distance between the point and their centers, and
+ * the remaining entries are padded with -1. Only the counters in the phi grid cells
+ * around the point are checked.
+ */
+void predict_tof_counters( double x, double y, double z, int64_t k, double phi_tol,
+                           double z_tol, double r_tol, int64_t* gids,
+                           std::vector<std::pair<double, int64_t>>& found ) {
+    found.clear();
+    std::fill( gids, gids + k, -1 );
+    if ( !std::isfinite( x ) || !std::isfinite( y ) || !std::isfinite( z ) ) return;
+
+    double r   = std::hypot( x, y );
+    double phi = wrap_phi( std::atan2( y, x ) );
+
+    int first   = static_cast<int>( wrap_phi( phi - phi_tol ) / GRID_DPHI );
+    int n_cells = std::min( static_cast<int>( 2 * phi_tol / GRID_DPHI ) + 2, GRID_N_PHI );
+    for ( int i = 0; i < n_cells; ++i )
+    {
+        int cell = ( first + i ) % GRID_N_PHI;
+        for ( auto j = _counter_grid_offsets[cell]; j < _counter_grid_offsets[cell + 1]; ++j )
+        {
+            auto gid = _counter_grid_gids[j];
+            if ( z < _counter_z_min[gid] - z_tol || z > _counter_z_max[gid] + z_tol ) continue;
+            if ( r < _counter_r_min[gid] - r_tol || r > _counter_r_max[gid] + r_tol ) continue;
+            if ( !in_phi_range( phi, _counter_phi_min[gid], _counter_phi_max[gid], phi_tol ) )
+                continue;
+
+            double dx = x - _counter_center_x[gid];
+            double dy = y - _counter_center_y[gid];
+            double dz = z - _counter_center_z[gid];
+            found.emplace_back( dx * dx + dy * dy + dz * dz, gid );
+        }
+    }
+
+    // a counter spans several cells
+    std::sort( found.begin(), found.end() );
+    found.erase( std::unique( found.begin(), found.end() ), found.end() );
+
+    int64_t n = std::min( k, static_cast<int64_t>( found.size() ) );
+    for ( int64_t i = 0; i < n; ++i ) gids[i] = found[i].second;
+}
+
+PyObject* _tof_predict_counters( PyObject* self, PyObject* args ) {
+    PyArrayObject *x = nullptr, *y = nullptr, *z = nullptr;
+    Py_ssize_t k   = 0;
+    double phi_tol = 0, z_tol = 0, r_tol = 0;
+
+    if ( !PyArg_ParseTuple( args, "O!O!O!nddd",                 //
+                            &PyArray_Type, &x,                //
+                            &PyArray_Type, &y,                //
+                            &PyArray_Type, &z,                //
+                            &k, &phi_tol, &z_tol, &r_tol ) )  //
+        return nullptr;
+
+    for ( auto arr : { x, y, z } )
+    {
+        if ( PyArray_TYPE( arr ) != NPY_DOUBLE || PyArray_NDIM( arr ) != 1 ||
+             !PyArray_IS_C_CONTIGUOUS( arr ) || PyArray_SIZE( arr ) != PyArray_SIZE( x ) )
+        {
+            PyErr_SetString( PyExc_ValueError,
+                             "x, y, z must be contiguous 1D float64 arrays of the same size" );
+            return nullptr;
+        }
+    }
+
+    if ( k < 1 || k > static_cast<Py_ssize_t>( N_STRIPS ) )
+    {
+        PyErr_Format( PyExc_ValueError, "k must be in [1, %zu]", N_STRIPS );
+        return nullptr;
+    }
+
+    if ( !( phi_tol >= 0 ) || !( z_tol >= 0 ) || !( r_tol >= 0 ) )
+    {
+        PyErr_SetString( PyExc_ValueError, "Tolerances must be non-negative" );
+        return nullptr;
+    }
+
+    npy_intp n        = PyArray_SIZE( x );
+    npy_intp dims[2]  = { n, k };
+    PyObject* out_gid = PyArray_SimpleNew( 2, dims, NPY_INT64 );
+    if ( !out_gid ) return nullptr;
+
+    auto px   = static_cast<const double*>( PyArray_DATA( x ) );
+    auto py   = static_cast<const double*>( PyArray_DATA( y ) );
+    auto pz   = static_cast<const double*>( PyArray_DATA( z ) );
+    auto pgid = static_cast<int64_t*>( PyArray_DATA( (PyArrayObject*)out_gid ) );
+
+    auto run = [=]( int64_t start, int64_t stop ) {
+        std::vector<std::pair<double, int64_t>> found;
+        for ( int64_t i = start; i < stop; ++i )
+            predict_tof_counters( px[i], py[i], pz[i], k, phi_tol, z_tol, r_tol, pgid + i * k,
+                                  found );
+    };
+
+    Py_BEGIN_ALLOW_THREADS;
+    auto& pool = ThreadPool::instance();
+    if ( pool.should_split( n ) ) pool.parallel_for( n, run );
+    else run( 0, n );
+    Py_END_ALLOW_THREADS;
+
+    return out_gid;
+}
+
 void declare_tof( PyObject* d ) {
     if ( _import_array() < 0 ) return;
     if ( _import_umath() < 0 ) return;
@@ -146,6 +670,12 @@ void declare_tof( PyObject* d ) {
         get_tof_gid<uint64_t>, //
         get_tof_gid<int64_t>>( d, "get_tof_gid" );
 
+    decl_ufunc_11<               //
+        tof_id_to_gid<uint32_t>, //
+        tof_id_to_gid<uint64_t>, //
+        tof_id_to_gid<int64_t>>  //
+        ( d, "tof_id_to_gid" );
+
     decl_ufunc_11<                 //
         tof_gid_to_part<uint16_t>, //
         tof_gid_to_part<int16_t>,  //
@@ -170,6 +700,78 @@ void declare_tof( PyObject* d ) {
         tof_gid_to_phi_or_strip<uint64_t>, //
         tof_gid_to_phi_or_strip<int64_t>>( d, "tof_gid_to_phi_or_strip" );
 
+    decl_ufunc_11<                     //
+        tof_gid_to_center_x<uint16_t>, //
+        tof_gid_to_center_x<int16_t>,  //
+        tof_gid_to_center_x<uint32_t>, //
+        tof_gid_to_center_x<int32_t>,  //
+        tof_gid_to_center_x<uint64_t>, //
+        tof_gid_to_center_x<int64_t>>( d, "tof_gid_to_center_x" );
+
+    decl_ufunc_11<                     //
+        tof_gid_to_center_y<uint16_t>, //
+        tof_gid_to_center_y<int16_t>,  //
+        tof_gid_to_center_y<uint32_t>, //
+        tof_gid_to_center_y<int32_t>,  //
+        tof_gid_to_center_y<uint64_t>, //
+        tof_gid_to_center_y<int64_t>>( d, "tof_gid_to_center_y" );
+
+    decl_ufunc_11<                     //
+        tof_gid_to_center_z<uint16_t>, //
+        tof_gid_to_center_z<int16_t>,  //
+        tof_gid_to_center_z<uint32_t>, //
+        tof_gid_to_center_z<int32_t>,  //
+        tof_gid_to_center_z<uint64_t>, //
+        tof_gid_to_center_z<int64_t>>( d, "tof_gid_to_center_z" );
+
+    decl_ufunc_11<                    //
+        tof_gid_to_phi_min<uint16_t>, //
+        tof_gid_to_phi_min<int16_t>,  //
+        tof_gid_to_phi_min<uint32_t>, //
+        tof_gid_to_phi_min<int32_t>,  //
+        tof_gid_to_phi_min<uint64_t>, //
+        tof_gid_to_phi_min<int64_t>>( d, "tof_gid_to_phi_min" );
+
+    decl_ufunc_11<                    //
+        tof_gid_to_phi_max<uint16_t>, //
+        tof_gid_to_phi_max<int16_t>,  //
+        tof_gid_to_phi_max<uint32_t>, //
+        tof_gid_to_phi_max<int32_t>,  //
+        tof_gid_to_phi_max<uint64_t>, //
+        tof_gid_to_phi_max<int64_t>>( d, "tof_gid_to_phi_max" );
+
+    decl_ufunc_11<                  //
+        tof_gid_to_z_min<uint16_t>, //
+        tof_gid_to_z_min<int16_t>,  //
+        tof_gid_to_z_min<uint32_t>, //
+        tof_gid_to_z_min<int32_t>,  //
+        tof_gid_to_z_min<uint64_t>, //
+        tof_gid_to_z_min<int64_t>>( d, "tof_gid_to_z_min" );
+
+    decl_ufunc_11<                  //
+        tof_gid_to_z_max<uint16_t>, //
+        tof_gid_to_z_max<int16_t>,  //
+        tof_gid_to_z_max<uint32_t>, //
+        tof_gid_to_z_max<int32_t>,  //
+        tof_gid_to_z_max<uint64_t>, //
+        tof_gid_to_z_max<int64_t>>( d, "tof_gid_to_z_max" );
+
+    decl_ufunc_11<                  //
+        tof_gid_to_r_min<uint16_t>, //
+        tof_gid_to_r_min<int16_t>,  //
+        tof_gid_to_r_min<uint32_t>, //
+        tof_gid_to_r_min<int32_t>,  //
+        tof_gid_to_r_min<uint64_t>, //
+        tof_gid_to_r_min<int64_t>>( d, "tof_gid_to_r_min" );
+
+    decl_ufunc_11<                  //
+        tof_gid_to_r_max<uint16_t>, //
+        tof_gid_to_r_max<int16_t>,  //
+        tof_gid_to_r_max<uint32_t>, //
+        tof_gid_to_r_max<int32_t>,  //
+        tof_gid_to_r_max<uint64_t>, //
+        tof_gid_to_r_max<int64_t>>( d, "tof_gid_to_r_max" );
+
     /* ------ Hit Status ------ */
 
     decl_ufunc_11<                          //
@@ -275,4 +877,12 @@ void declare_tof( PyObject* d ) {
         tof_hit_status_to_is_mrpc<int32_t>,  //
         tof_hit_status_to_is_mrpc<uint64_t>, //
         tof_hit_status_to_is_mrpc<int64_t>>( d, "tof_hit_status_to_is_mrpc" );
+
+    decl_ufunc<1, 3,                    //
+               parse_tof_gid<uint16_t>, //
+               parse_tof_gid<int16_t>,  //
+               parse_tof_gid<uint32_t>, //
+               parse_tof_gid<int32_t>,  //
+               parse_tof_gid<uint64_t>, //
+               parse_tof_gid<int64_t>>( d, "parse_tof_gid" );
 }
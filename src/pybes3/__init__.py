@@ -8,10 +8,13 @@ from pybes3.cgem import (
     cgem_gid_to_sheet,
     cgem_gid_to_strip,
     cgem_gid_to_strip_type,
+    cgem_xv_intersection,
+    cluster_cgem_strips,
     get_cgem_gid,
     parse_cgem_gid,
 )
 from pybes3.emc import (
+    cluster_emc_hits,
     emc_adc_to_charge,
     emc_gid_to_center_x,
     emc_gid_to_center_y,
@@ -19,22 +22,27 @@ from pybes3.emc import (
     emc_gid_to_front_center_x,
     emc_gid_to_front_center_y,
     emc_gid_to_front_center_z,
+    emc_gid_to_neighbours,
     emc_gid_to_part,
     emc_gid_to_phi,
     emc_gid_to_point_x,
     emc_gid_to_point_y,
     emc_gid_to_point_z,
     emc_gid_to_theta,
+    emc_shower_shape,
     get_emc_crystal_position,
     get_emc_geom_table,
     get_emc_gid,
+    match_emc_crystals,
     parse_emc_gid,
 )
+from pybes3.events import reduce_events
 from pybes3.helix import (
     HelixObject,
     dr_phi0_to_x,
     dr_phi0_to_y,
     helix_awk,
+    helix_kinematics,
     helix_obj,
     kappa_to_charge,
     kappa_to_pt,
@@ -59,17 +67,50 @@ from pybes3.mdc import (
     mdc_gid_to_wire,
     mdc_gid_z_to_x,
     mdc_gid_z_to_y,
+    mdc_helix_doca,
+    mdc_layer_nearest_wire,
     mdc_layer_to_is_stereo,
     mdc_layer_to_superlayer,
     parse_mdc_gid,
 )
+from pybes3.monitor import ChannelHistogram
+from pybes3.muc import (
+    get_muc_gid,
+    init_muc_geom,
+    muc_gid_to_center_x,
+    muc_gid_to_center_y,
+    muc_gid_to_center_z,
+    muc_gid_to_dir_x,
+    muc_gid_to_dir_y,
+    muc_gid_to_dir_z,
+    muc_gid_to_gap,
+    muc_gid_to_is_barrel,
+    muc_gid_to_length,
+    muc_gid_to_part,
+    muc_gid_to_segment,
+    muc_gid_to_strip,
+    parse_muc_gid,
+)
+from pybes3.parallel import get_num_threads, get_parallel_threshold, set_num_threads
 from pybes3.tof import (
     get_tof_gid,
+    init_tof_geom,
+    pair_tof_ends,
     parse_tof_gid,
     parse_tof_hit_status,
+    predict_tof_counters,
+    tof_gid_to_center_x,
+    tof_gid_to_center_y,
+    tof_gid_to_center_z,
     tof_gid_to_layer_or_module,
     tof_gid_to_part,
+    tof_gid_to_phi_max,
+    tof_gid_to_phi_min,
     tof_gid_to_phi_or_strip,
+    tof_gid_to_r_max,
+    tof_gid_to_r_min,
+    tof_gid_to_z_max,
+    tof_gid_to_z_min,
     tof_hit_status_to_is_barrel,
     tof_hit_status_to_is_cluster,
     tof_hit_status_to_is_counter,
@@ -86,6 +127,8 @@ from pybes3.tof import (
 )
 
 __all__ = [
+    # monitoring
+    "ChannelHistogram",
     # tracks
     "HelixObject",
     "__version__",
@@ -96,6 +139,9 @@ __all__ = [
     "cgem_gid_to_sheet",
     "cgem_gid_to_strip",
     "cgem_gid_to_strip_type",
+    "cgem_xv_intersection",
+    "cluster_cgem_strips",
+    "cluster_emc_hits",
     "concatenate",
     "concatenate_raw",
     "dr_phi0_to_x",
@@ -107,12 +153,14 @@ __all__ = [
     "emc_gid_to_front_center_x",
     "emc_gid_to_front_center_y",
     "emc_gid_to_front_center_z",
+    "emc_gid_to_neighbours",
     "emc_gid_to_part",
     "emc_gid_to_phi",
     "emc_gid_to_point_x",
     "emc_gid_to_point_y",
     "emc_gid_to_point_z",
     "emc_gid_to_theta",
+    "emc_shower_shape",
     "get_cgem_gid",
     "get_emc_crystal_position",
     "get_emc_geom_table",
@@ -120,12 +168,19 @@ __all__ = [
     "get_mdc_geom_table",
     "get_mdc_gid",
     "get_mdc_wire_position",
+    "get_muc_gid",
+    "get_num_threads",
+    "get_parallel_threshold",
     "get_tof_gid",
     "helix_awk",
+    "helix_kinematics",
     "helix_obj",
+    "init_muc_geom",
+    "init_tof_geom",
     "kappa_to_charge",
     "kappa_to_pt",
     "kappa_to_radius",
+    "match_emc_crystals",
     "mdc_gid_to_east_x",
     "mdc_gid_to_east_y",
     "mdc_gid_to_east_z",
@@ -139,20 +194,48 @@ __all__ = [
     "mdc_gid_to_wire",
     "mdc_gid_z_to_x",
     "mdc_gid_z_to_y",
+    "mdc_helix_doca",
+    "mdc_layer_nearest_wire",
     "mdc_layer_to_is_stereo",
     "mdc_layer_to_superlayer",
+    "muc_gid_to_center_x",
+    "muc_gid_to_center_y",
+    "muc_gid_to_center_z",
+    "muc_gid_to_dir_x",
+    "muc_gid_to_dir_y",
+    "muc_gid_to_dir_z",
+    "muc_gid_to_gap",
+    "muc_gid_to_is_barrel",
+    "muc_gid_to_length",
+    "muc_gid_to_part",
+    "muc_gid_to_segment",
+    "muc_gid_to_strip",
     # besio
     "open",
     "open_raw",
+    "pair_tof_ends",
     "parse_cgem_gid",
     "parse_emc_gid",
     "parse_mdc_gid",
+    "parse_muc_gid",
     "parse_tof_gid",
     "parse_tof_hit_status",
     "phi0_to_phi",
+    "predict_tof_counters",
+    "reduce_events",
+    "set_num_threads",
+    "tof_gid_to_center_x",
+    "tof_gid_to_center_y",
+    "tof_gid_to_center_z",
     "tof_gid_to_layer_or_module",
     "tof_gid_to_part",
+    "tof_gid_to_phi_max",
+    "tof_gid_to_phi_min",
     "tof_gid_to_phi_or_strip",
+    "tof_gid_to_r_max",
+    "tof_gid_to_r_min",
+    "tof_gid_to_z_max",
+    "tof_gid_to_z_min",
     "tof_hit_status_to_is_barrel",
     "tof_hit_status_to_is_cluster",
     "tof_hit_status_to_is_counter",
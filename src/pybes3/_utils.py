@@ -50,3 +50,140 @@ def _flat_to_numpy(array: ak.Array | ak.Record | np.ndarray | float) -> np.ndarr
         return ak.flatten(array, axis=None).to_numpy()
     else:
         return array
+
+
+def _event_offsets(arr: ak.Array) -> tuple[np.ndarray, np.ndarray]:
+    """
+    Computes the event offsets of an array in shape `(n_events, var)`.
+
+    Args:
+        arr: The input awkward array.
+
+    Returns:
+        The counts and the offsets (in `int64`) of `arr`.
+    """
+    counts = ak.num(arr, axis=1).to_numpy()
+    offsets = np.zeros(len(counts) + 1, dtype=np.int64)
+    np.cumsum(counts, out=offsets[1:])
+    return counts, offsets
+
+
+def _flat_events(arr: ak.Array, dtype) -> tuple[np.ndarray, np.ndarray, np.ndarray]:
+    """
+    Flattens an array in shape `(n_events, var)` for the per-event kernels.
+
+    Args:
+        arr: The input awkward array.
+        dtype: The dtype of the flat content.
+
+    Returns:
+        The counts, the offsets (in `int64`) and the contiguous flat content of `arr`.
+    """
+    counts, offsets = _event_offsets(arr)
+    flat = np.ascontiguousarray(ak.flatten(arr).to_numpy(), dtype=dtype)
+    return counts, offsets, flat
+
+
+def _flat_float64(arr) -> np.ndarray:
+    """
+    Flattens an array-like to a contiguous 1D `float64` array for the native kernels.
+    """
+    return np.ascontiguousarray(arr, dtype=np.float64).reshape(-1)
+
+
+def _unwrap_lists(layout: ak.contents.Content) -> tuple[list, np.ndarray] | None:
+    lists = []
+    list_types = (awkward.contents.ListOffsetArray, awkward.contents.RegularArray)
+    while isinstance(layout, list_types):
+        lists.append(layout)
+        layout = layout.content
+
+    if not isinstance(layout, awkward.contents.NumpyArray) or layout.data.ndim != 1:
+        return None
+
+    # strings and other special arrays are left to awkward
+    if layout.parameter("__array__") is not None:
+        return None
+
+    return lists, layout.data
+
+
+def _same_lists(lists1: list, lists2: list) -> bool:
+    if len(lists1) != len(lists2):
+        return False
+
+    for l1, l2 in zip(lists1, lists2):
+        if type(l1) is not type(l2) or l1.length != l2.length:
+            return False
+
+        if isinstance(l1, awkward.contents.RegularArray):
+            if l1.size != l2.size:
+                return False
+        elif l1.offsets is not l2.offsets and not np.array_equal(
+            l1.offsets.data, l2.offsets.data
+        ):
+            return False
+
+    return True
+
+
+def _rewrap_lists(lists: list, data: np.ndarray) -> ak.contents.Content:
+    layout = awkward.contents.NumpyArray(data)
+    for lst in reversed(lists):
+        if isinstance(lst, awkward.contents.RegularArray):
+            layout = awkward.contents.RegularArray(
+                layout, lst.size, zeros_length=lst.length, parameters=lst.parameters
+            )
+        else:
+            layout = awkward.contents.ListOffsetArray(
+                lst.offsets, layout, parameters=lst.parameters
+            )
+    return layout
+
+
+def _apply_jagged(ufunc: np.ufunc, *args):
+    """
+    Applies a ufunc kernel on the flat content of jagged arrays.
+
+    `ak.Array` arguments that are (nested) lists of numbers are unwrapped to their flat
+    numpy buffers, the kernel runs once on them, and the outputs are wrapped back with
+    the original offsets. This skips the broadcasting of awkward's `__array_ufunc__`.
+    Other inputs, or `ak.Array` arguments with different list structures, are passed
+    to the ufunc directly.
+
+    Args:
+        ufunc: The ufunc kernel from `pybes3.kernels.ufuncs`.
+        *args: Input arguments of the ufunc. Non-array arguments are treated as scalars.
+
+    Returns:
+        The output array, or a tuple of output arrays if the ufunc has multiple outputs.
+    """
+    ref = None
+    flat_args = []
+    for arg in args:
+        if isinstance(arg, ak.Array):
+            unwrapped = _unwrap_lists(arg.layout) if ak.backend(arg) == "cpu" else None
+            if unwrapped is None:
+                return ufunc(*args)
+
+            lists, data = unwrapped
+            if ref is None:
+                ref = (arg, lists, data.shape)
+            elif data.shape != ref[2] or not _same_lists(lists, ref[1]):
+                return ufunc(*args)
+
+            flat_args.append(data)
+        elif isinstance(arg, np.ndarray) and arg.ndim > 0:
+            return ufunc(*args)
+        else:
+            flat_args.append(arg)
+
+    if ref is None:
+        return ufunc(*args)
+
+    ref_arr, ref_lists, _ = ref
+    res = ufunc(*flat_args)
+    if ufunc.nout == 1:
+        return ak.Array(_rewrap_lists(ref_lists, res), behavior=ref_arr.behavior)
+
+    return tuple(ak.Array(_rewrap_lists(ref_lists, r), behavior=ref_arr.behavior) for r in res)
@@ -6,7 +6,8 @@ import awkward as ak
 import numpy as np
 
 import pybes3.kernels.ufuncs as _ufuncs
-from pybes3.typing import BoolLike, IntLike
+from pybes3._utils import _apply_jagged, _flat_events
+from pybes3.typing import BoolLike, FloatLike, IntLike
 
 N_LAYER = 3
 N_STRIPS = 9897
@@ -131,12 +132,9 @@ def parse_cgem_gid(gid: IntLike) -> ak.Array | dict[str, Any]:
         Otherwise, returns a dictionary with keys "layer", "sheet", "strip_type", "strip",
         "is_xstrip" and "is_vstrip".
     """
-    layer = _ufuncs.cgem_gid_to_layer(gid)
-    sheet = _ufuncs.cgem_gid_to_sheet(gid)
-    strip_type = _ufuncs.cgem_gid_to_strip_type(gid)
-    strip = _ufuncs.cgem_gid_to_strip(gid)
-    is_xstrip = _ufuncs.cgem_gid_to_is_xstrip(gid)
-    is_vstrip = _ufuncs.cgem_gid_to_is_vstrip(gid)
+    layer, sheet, strip_type, strip, is_xstrip, is_vstrip = _apply_jagged(
+        _ufuncs.parse_cgem_gid, gid
+    )
 
     res = {
         "layer": layer,
@@ -151,3 +149,128 @@ def parse_cgem_gid(gid: IntLike) -> ak.Array | dict[str, Any]:
         return ak.zip(res)
     else:
         return res
+
+
+def cluster_cgem_strips(
+    gid: ak.Array, charge: ak.Array, max_gap: int = 0
+) -> tuple[ak.Array, ak.Array]:
+    """
+    Group the fired CGEM strips of each event into clusters of adjacent strips.
+
+    Strips of the same layer and strip type are in the same cluster when their strip
+    numbers differ by at most `max_gap + 1`. X strips of a layer are counted in phi over
+    all its sheets, so they are adjacent across the sheet boundaries and across phi = 0.
+    V strips are clustered within their sheet.
+
+    Fields of the clusters:
+
+    - `gid`: gid of the first strip of the cluster in phi.
+    - `layer`, `sheet`, `strip_type`: Layer, sheet and strip type of the first strip.
+    - `strip`: Charge-weighted centroid in units of strips, counted from the sheet of the
+        first strip. It goes past the last strip of that sheet for X clusters across a
+        sheet boundary or phi = 0. Clusters without positive charge sum use the mean
+        strip number.
+    - `charge`: Charge sum of the cluster.
+    - `size`: Number of strips in the cluster.
+
+    Parameters:
+        gid: The gid of the fired strips, in shape `(n_events, var)`.
+        charge: The charge of the fired strips, in the same shape as `gid`.
+        max_gap: Maximal number of missing strips inside a cluster.
+
+    Returns:
+        Tuple of the cluster index of each strip within its event, in the same shape as
+            `gid` (`-1` for invalid gid), and the clusters in shape `(n_events, n_clusters)`,
+            sorted by the gid of their first strip.
+    """
+    gid, charge = ak.broadcast_arrays(gid, charge)
+    if gid.ndim != 2:
+        raise ValueError("gid and charge must be in shape (n_events, var)")
+
+    counts, offsets, flat_gid = _flat_events(gid, np.int64)
+    flat_charge = _flat_events(charge, np.float64)[2]
+    cluster_id, cluster_offsets, cl_gid, cl_strip, cl_charge, cl_size = (
+        _ufuncs._cgem_cluster_strips(offsets, flat_gid, flat_charge, max_gap)
+    )
+
+    layer, sheet, strip_type, *_ = _ufuncs.parse_cgem_gid(cl_gid)
+    clusters = {
+        "gid": cl_gid,
+        "layer": layer,
+        "sheet": sheet,
+        "strip_type": strip_type,
+        "strip": cl_strip,
+        "charge": cl_charge,
+        "size": cl_size,
+    }
+
+    n_clusters = np.diff(cluster_offsets)
+    return (
+        ak.unflatten(cluster_id, counts),
+        ak.zip({k: ak.unflatten(v, n_clusters) for k, v in clusters.items()}),
+    )
+
+
+def cgem_xv_intersection(
+    clusters: ak.Array,
+    radius: FloatLike,
+    stereo_angle: FloatLike,
+    v_pitch: FloatLike,
+    v_offset: FloatLike,
+    half_length: FloatLike,
+) -> ak.Array:
+    """
+    Intersect X and V strip clusters of the same layer and sheet into space points.
+
+    Each sheet is unrolled to `(s, z)`, where `s = radius * phi` is measured from the
+    start of the sheet. X strips are parallel to the z axis and evenly cover the
+    circumference, so X strip `k` is at `s = (k + 0.5) * 2 * pi * radius / n_x`, where
+    `n_x` is the number of X strips in the layer (`N_SHEETS * N_XSTRIPS`). V strip `j` is
+    the line `s = v_offset + (j + 0.5) * v_pitch + z * tan(stereo_angle)`.
+
+    The geometry parameters are given per layer (arrays of length 3) or as scalars for
+    all layers, take them from the CGEM geometry of the run being analysed.
+
+    Fields of the output:
+
+    - `x`, `y`, `z`: Position of the intersection.
+    - `layer`, `sheet`: Layer and sheet of the intersection.
+    - `x_cluster`, `v_cluster`: Index of the X and V cluster within the event.
+
+    Parameters:
+        clusters: Clusters returned by `cluster_cgem_strips`.
+        radius: Radius of the readout plane of each layer.
+        stereo_angle: Angle between V strips and the z axis of each layer, in radians.
+        v_pitch: Pitch of V strips along `s` of each layer.
+        v_offset: `s` of the lower edge of V strip 0 at `z = 0` of each layer.
+        half_length: Intersections with `|z| > half_length` are dropped.
+
+    Returns:
+        The intersections in shape `(n_events, n_points)`.
+    """
+    geometry = np.array(
+        [
+            np.broadcast_to(v, N_LAYER)
+            for v in (radius, np.tan(stereo_angle), v_pitch, v_offset, half_length)
+        ],
+        dtype=np.float64,
+    )
+
+    _, offsets, flat_gid = _flat_events(clusters["gid"], np.int64)
+    flat_strip = _flat_events(clusters["strip"], np.float64)[2]
+    point_offsets, x_cluster, v_cluster, x, y, z = _ufuncs._cgem_xv_intersection(
+        offsets, flat_gid, flat_strip, geometry
+    )
+
+    n_points = np.diff(point_offsets)
+    x_gid = flat_gid[x_cluster + np.repeat(offsets[:-1], n_points)]
+    points = {
+        "x": x,
+        "y": y,
+        "z": z,
+        "layer": _ufuncs.cgem_gid_to_layer(x_gid),
+        "sheet": _ufuncs.cgem_gid_to_sheet(x_gid),
+        "x_cluster": x_cluster,
+        "v_cluster": v_cluster,
+    }
+    return ak.zip({k: ak.unflatten(v, n_points) for k, v in points.items()})
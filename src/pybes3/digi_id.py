@@ -7,8 +7,9 @@ import awkward as ak
 import numpy as np
 
 import pybes3.kernels.ufuncs as _ufuncs
-from pybes3.emc import get_emc_gid, parse_emc_gid
-from pybes3.mdc import get_mdc_gid, parse_mdc_gid
+from pybes3._utils import _apply_jagged
+from pybes3.emc import parse_emc_gid
+from pybes3.mdc import parse_mdc_gid
 from pybes3.typing import BoolLike, IntLike
 
 warnings.warn(
@@ -195,9 +196,8 @@ def parse_mdc_digi_id(
     Returns:
         The parsed result.
     """
-    wire = mdc_id_to_wire(mdc_digi_id)
-    layer = mdc_id_to_layer(mdc_digi_id)
-    gid = get_mdc_gid(layer, wire)
+    layer, wire, _ = _apply_jagged(_ufuncs.parse_mdc_id, mdc_digi_id)
+    gid = _apply_jagged(_ufuncs.get_mdc_gid, layer, wire)
     return parse_mdc_gid(gid, with_pos)
 
 
@@ -476,12 +476,12 @@ def parse_tof_digi_id(
     if flat and isinstance(tof_digi_id, ak.Array):
         tof_digi_id = ak.flatten(tof_digi_id)
 
-    part = tof_id_to_part(tof_digi_id)
+    part, layer_or_module, phi_or_strip, end = _apply_jagged(_ufuncs.parse_tof_id, tof_digi_id)
     res = {
         "part": part,
-        "layer_or_module": tof_id_to_layer_or_module(tof_digi_id, part),
-        "phi_or_strip": tof_id_to_phi_or_strip(tof_digi_id, part),
-        "end": tof_id_to_end(tof_digi_id),
+        "layer_or_module": layer_or_module,
+        "phi_or_strip": phi_or_strip,
+        "end": end,
     }
 
     if library == "ak":
@@ -602,10 +602,8 @@ def parse_emc_digi_id(
         The parsed EMC digi ID.
 
     """
-    part = emc_id_to_module(emc_digi_id)
-    theta = emc_id_to_theta(emc_digi_id)
-    phi = emc_id_to_phi(emc_digi_id)
-    gid = get_emc_gid(part, theta, phi)
+    part, theta, phi = _apply_jagged(_ufuncs.parse_emc_id, emc_digi_id)
+    gid = _apply_jagged(_ufuncs.get_emc_gid, part, theta, phi)
     return parse_emc_gid(gid, with_pos)
 
 
@@ -815,10 +813,7 @@ def parse_muc_digi_id(
     if flat and isinstance(muc_digi_id, ak.Array):
         muc_digi_id = ak.flatten(muc_digi_id)
 
-    part = muc_id_to_part(muc_digi_id)
-    segment = muc_id_to_segment(muc_digi_id)
-    layer = muc_id_to_layer(muc_digi_id)
-    channel = muc_id_to_channel(muc_digi_id)
+    part, segment, layer, channel = _apply_jagged(_ufuncs.parse_muc_id, muc_digi_id)
 
     res = {
         "part": part,
@@ -955,11 +950,12 @@ def parse_cgem_digi_id(
     if flat and isinstance(cgem_digi_id, ak.Array):
         cgem_digi_id = ak.flatten(cgem_digi_id)
 
+    layer, sheet, strip_type, strip = _apply_jagged(_ufuncs.parse_cgem_id, cgem_digi_id)
     res = {
-        "layer": cgem_id_to_layer(cgem_digi_id),
-        "sheet": cgem_id_to_sheet(cgem_digi_id),
-        "strip_type": cgem_id_to_strip_type(cgem_digi_id),
-        "strip": cgem_id_to_strip(cgem_digi_id),
+        "layer": layer,
+        "sheet": sheet,
+        "strip_type": strip_type,
+        "strip": strip,
     }
 
     if library == "ak":
@@ -6,6 +6,13 @@ import awkward as ak
 import numpy as np
 
 import pybes3.kernels.ufuncs as _ufuncs
+from pybes3._utils import (
+    _apply_jagged,
+    _flat_events,
+    _flat_float64,
+    _rewrap_lists,
+    _unwrap_lists,
+)
 from pybes3.data import EMC_GEOM
 from pybes3.typing import FloatLike, IntLike
 
@@ -61,6 +68,9 @@ _ufuncs._init_emc_geom(
     _front_center_z,
 )
 
+_neighbours = _ufuncs._emc_neighbours()
+_neighbours.setflags(write=False)
+
 
 def get_emc_geom_table(library: Literal["np", "ak", "pd"] = "np"):
     """
@@ -353,19 +363,20 @@ def parse_emc_gid(gid: IntLike, geometry: bool = False) -> ak.Array | dict[str,
     Returns:
         The parsed result.
     """
-    part = _ufuncs.emc_gid_to_part(gid)
-    theta = _ufuncs.emc_gid_to_theta(gid)
-    phi = _ufuncs.emc_gid_to_phi(gid)
+    part, theta, phi = _apply_jagged(_ufuncs.parse_emc_gid, gid)
 
     res = {"gid": gid, "part": part, "theta": theta, "phi": phi}
 
     if geometry:
-        res["front_center_x"] = _ufuncs.emc_gid_to_front_center_x(gid)
-        res["front_center_y"] = _ufuncs.emc_gid_to_front_center_y(gid)
-        res["front_center_z"] = _ufuncs.emc_gid_to_front_center_z(gid)
-        res["center_x"] = _ufuncs.emc_gid_to_center_x(gid)
-        res["center_y"] = _ufuncs.emc_gid_to_center_y(gid)
-        res["center_z"] = _ufuncs.emc_gid_to_center_z(gid)
+        geom_keys = [
+            "front_center_x",
+            "front_center_y",
+            "front_center_z",
+            "center_x",
+            "center_y",
+            "center_z",
+        ]
+        res.update(zip(geom_keys, _apply_jagged(_ufuncs.emc_gid_to_geometry, gid)))
 
     if isinstance(gid, ak.Array):
         return ak.zip(res)
@@ -387,3 +398,171 @@ def emc_adc_to_charge(measure: IntLike, adc: IntLike) -> FloatLike:
         The charge of the crystal.
     """
     return _ufuncs.emc_adc_to_charge(measure, adc)
+
+
+def match_emc_crystals(
+    x: FloatLike, y: FloatLike, z: FloatLike, k: int = 9
+) -> tuple[IntLike, IntLike, FloatLike]:
+    """
+    Match points on the EMC front face, e.g. tracks extrapolated to the EMC, to crystals.
+
+    Crystals are ranked by the distance between the point and their front centers. A
+    theta/phi grid over the crystals is used, so only crystals around the point are
+    checked.
+
+    Parameters:
+        x: x coordinate of the points in cm.
+        y: y coordinate of the points in cm.
+        z: z coordinate of the points in cm.
+        k: Number of nearest crystals to return.
+
+    Returns:
+        Tuple of the gid of the crystal the point enters (the nearest one), the gids of
+            the `k` nearest crystals and their distances to the point. The last two have an
+            additional trailing dimension of length `k`, sorted by distance. Points at the
+            origin or with non-finite coordinates get gid `-1` and distance `NaN`.
+    """
+    if isinstance(x, ak.Array) or isinstance(y, ak.Array) or isinstance(z, ak.Array):
+        x, y, z = (ak.to_packed(a) for a in ak.broadcast_arrays(x, y, z))
+        unwrapped = _unwrap_lists(x.layout)
+        if unwrapped is None:
+            raise TypeError("x, y and z must be (nested) lists of numbers")
+
+        lists, _ = unwrapped
+        near_gid, near_dist = _ufuncs._emc_match_crystals(
+            *(_flat_float64(ak.flatten(a, axis=None).to_numpy()) for a in (x, y, z)), k
+        )
+        return (
+            ak.Array(_rewrap_lists(lists, near_gid[:, 0].copy())),
+            ak.Array(_rewrap_lists(lists, near_gid)),
+            ak.Array(_rewrap_lists(lists, near_dist)),
+        )
+
+    x, y, z = np.broadcast_arrays(x, y, z)
+    flat_xyz = (_flat_float64(a) for a in (x, y, z))
+    near_gid, near_dist = _ufuncs._emc_match_crystals(*flat_xyz, k)
+
+    near_gid = near_gid.reshape(*x.shape, k)
+    near_dist = near_dist.reshape(*x.shape, k)
+    return near_gid[..., 0][()], near_gid, near_dist
+
+
+def emc_gid_to_neighbours(gid: IntLike) -> IntLike:
+    """
+    Get the neighbouring crystals of EMC crystals.
+
+    Crystals in the same or adjacent theta rings are neighbours if their phi ranges
+    overlap or touch, including the diagonal ones. The table wraps around in phi and
+    connects the barrel to the endcaps.
+
+    The phi ranges are taken from the crystal indices, without the per-ring phi offsets
+    of the real geometry. A neighbour in an adjacent ring can then be up to ~1.4 times
+    further away than the closest crystal of that ring.
+
+    Parameters:
+        gid: The gid of the crystal.
+
+    Returns:
+        The gids of the neighbouring crystals, as an additional trailing dimension of
+            length 8, padded with `-1`. Rows of gids out of `[0, N_CRYSTALS)` are all `-1`.
+    """
+    if isinstance(gid, ak.Array):
+        unwrapped = _unwrap_lists(ak.to_packed(gid).layout)
+        if unwrapped is None:
+            raise TypeError("gid must be (nested) lists of integers")
+
+        lists, data = unwrapped
+        return ak.Array(_rewrap_lists(lists, _gid_neighbours(data)))
+
+    return _gid_neighbours(gid)
+
+
+def _gid_neighbours(gid: IntLike) -> np.ndarray:
+    gid = np.asarray(gid)
+    valid = (gid >= 0) & (gid < N_CRYSTALS)
+    res = _neighbours[np.where(valid, gid, 0)]
+    return np.where(valid[..., None], res, -1).astype(_neighbours.dtype, copy=False)
+
+
+def cluster_emc_hits(gid: ak.Array, energy: ak.Array) -> tuple[ak.Array, ak.Array, ak.Array]:
+    """
+    Group the EMC hits of each event into clusters of neighbouring crystals.
+
+    Clusters are the connected components of hits, where hits on neighbouring crystals
+    (see `emc_gid_to_neighbours`) are connected.
+
+    Parameters:
+        gid: The gid of the hits, in shape `(n_events, var)`.
+        energy: The energy of the hits, in the same shape as `gid`.
+
+    Returns:
+        Tuple of the cluster index of each hit within its event, the seed gid (the crystal
+            of the most energetic hit) and the energy sum of each cluster. The cluster
+            index has the same shape as `gid`, and hits with invalid gid get `-1`. The
+            seeds and energy sums are in shape `(n_events, n_clusters)`, ordered by the
+            first hit of each cluster.
+    """
+    gid, energy = ak.broadcast_arrays(gid, energy)
+    if gid.ndim != 2:
+        raise ValueError("gid and energy must be in shape (n_events, var)")
+
+    counts, offsets, flat_gid = _flat_events(gid, np.int64)
+    flat_energy = _flat_events(energy, np.float64)[2]
+    cluster_id, cluster_offsets, seed, cluster_energy = _ufuncs._emc_cluster_hits(
+        offsets, flat_gid, flat_energy
+    )
+
+    n_clusters = np.diff(cluster_offsets)
+    return (
+        ak.unflatten(cluster_id, counts),
+        ak.unflatten(seed, n_clusters),
+        ak.unflatten(cluster_energy, n_clusters),
+    )
+
+
+def emc_shower_shape(
+    gid: ak.Array, energy: ak.Array, seed: ak.Array, log_weight: float = 4.0
+) -> ak.Array:
+    """
+    Compute the shower shape variables around seed crystals, e.g. the seeds returned by
+    `cluster_emc_hits`.
+
+    The 3x3 and 5x5 regions are the crystals within 1 and 2 steps in the neighbour table
+    (see `emc_gid_to_neighbours`) around the seed. The centroid is the mean of the front
+    centers of crystals in the 5x5 region, weighted by `max(0, log_weight + ln(E / E5x5))`.
+    The lateral moment is `sum(E_i * r_i^2) / (sum(E_i * r_i^2) + (E_0 + E_1) * r0^2)`,
+    with crystal energies `E_i` in the 5x5 region sorted in descending order, the sum
+    starting from `i = 2`, `r_i` the distance to the centroid and `r0 = 5.2` cm.
+
+    Fields of the output:
+
+    - `e1`: Energy of the seed crystal.
+    - `e3x3`: Energy sum of the 3x3 region.
+    - `e5x5`: Energy sum of the 5x5 region.
+    - `e1_e9`: Ratio of `e1` to `e3x3`.
+    - `x`, `y`, `z`: Position of the centroid in cm.
+    - `lat_moment`: Lateral moment.
+
+    Parameters:
+        gid: The gid of the hits, in shape `(n_events, var)`.
+        energy: The energy of the hits, in the same shape as `gid`.
+        seed: The gid of the seed crystals, in shape `(n_events, var)`.
+        log_weight: Offset of the logarithmic weights of the centroid.
+
+    Returns:
+        The shower shape variables of each seed, in the same shape as `seed`. Invalid
+            seeds get `NaN`.
+    """
+    gid, energy = ak.broadcast_arrays(gid, energy)
+    if gid.ndim != 2 or seed.ndim != 2 or len(seed) != len(gid):
+        raise ValueError("gid, energy and seed must be in shape (n_events, var)")
+
+    _, hit_offsets, flat_gid = _flat_events(gid, np.int64)
+    flat_energy = _flat_events(energy, np.float64)[2]
+    seed_counts, seed_offsets, flat_seed = _flat_events(seed, np.int64)
+
+    res = _ufuncs._emc_shower_shape(
+        hit_offsets, flat_gid, flat_energy, seed_offsets, flat_seed, log_weight
+    )
+    fields = ["e1", "e3x3", "e5x5", "e1_e9", "x", "y", "z", "lat_moment"]
+    return ak.zip({k: ak.unflatten(v, seed_counts) for k, v in zip(fields, res)})
@@ -0,0 +1,75 @@
+from __future__ import annotations
+
+from typing import Literal
+
+import awkward as ak
+import numpy as np
+
+import pybes3.kernels.ufuncs as _ufuncs
+from pybes3._utils import _event_offsets, _flat_events
+
+REDUCE_OPS = ("sum", "min", "max", "argmin", "argmax", "count")
+
+
+def reduce_events(
+    values: ak.Array | None,
+    op: Literal["sum", "min", "max", "argmin", "argmax", "count"] = "sum",
+    key: ak.Array | None = None,
+    n_keys: int | None = None,
+) -> np.ndarray:
+    """
+    Reduce the hits of each event, optionally grouped by an integer key of the hits.
+
+    The reduction runs on the flat content and the event offsets of the arrays, without
+    the intermediate masked arrays of `ak.sum`, `ak.argmax` etc. Large inputs are split
+    across the threads set by `set_num_threads`.
+
+    Parameters:
+        values: Values of the hits, in shape `(n_events, var)`. Only the structure is used
+            by `"count"`, where it can be `None` if `key` is given.
+        op: The reduction, one of `"sum"`, `"min"`, `"max"`, `"argmin"`, `"argmax"` and
+            `"count"`.
+        key: Integer key of the hits (e.g. `mdc_gid_to_superlayer(gid)`), with the same
+            structure as `values`. Hits with keys out of `[0, n_keys)` are skipped.
+        n_keys: Number of keys. Defaults to the maximal key plus 1. Only valid with `key`.
+
+    Returns:
+        The reduction of each event, in shape `(n_events,)` without `key`, or
+            `(n_events, n_keys)` with `key`. `"sum"`, `"min"` and `"max"` are `float64`,
+            the last two are `nan` when there is no (non-`nan`) hit. `"argmin"` and
+            `"argmax"` are the indices of the hits within the events, or `-1` when there
+            is no (non-`nan`) hit. `"count"` is `int64`, which makes
+            `reduce_events(None, "count", key)` a per-event histogram of the keys.
+    """
+    if op not in REDUCE_OPS:
+        raise ValueError(f"op must be one of {', '.join(REDUCE_OPS)}, got {op!r}")
+
+    if values is None and (op != "count" or key is None):
+        raise ValueError("values are required, except for count with key")
+
+    if key is None and n_keys is not None:
+        raise ValueError("n_keys is only valid with key")
+
+    for arr in (values, key):
+        if arr is not None and (not isinstance(arr, ak.Array) or arr.ndim != 2):
+            raise ValueError("values and key must be ak.Array in shape (n_events, var)")
+
+    offsets, flat_values, flat_key = None, None, None
+    if values is not None:
+        if op == "count":
+            offsets = _event_offsets(values)[1]
+        else:
+            _, offsets, flat_values = _flat_events(values, np.float64)
+
+    if key is not None:
+        _, key_offsets, flat_key = _flat_events(key, np.int64)
+        if offsets is not None and not np.array_equal(offsets, key_offsets):
+            raise ValueError("values and key must have the same number of hits per event")
+
+        offsets = key_offsets
+        if n_keys is None:
+            n_keys = max(int(flat_key.max()) + 1, 1) if len(flat_key) > 0 else 1
+
+    return _ufuncs._reduce_events(
+        offsets, flat_values, flat_key, 1 if n_keys is None else n_keys, op
+    )
@@ -13,7 +13,7 @@ import vector.backends.awkward as vec_ak
 vector.register_awkward()
 
 import pybes3.kernels.ufuncs as _ufuncs
-from pybes3._utils import _extract_index, _flat_to_numpy
+from pybes3._utils import _apply_jagged, _extract_index, _flat_to_numpy
 from pybes3.typing import FloatLike, IntLike
 
 TypeObjPosition = Union[vector.VectorObject3D, tuple[float, float, float]]
@@ -95,7 +95,8 @@ def _change_pivot(
 ):
     """
     Change the pivot point of the helix and transform its parameters accordingly.
-    The transformation is based on the BOSS `Helix::pivot` method.
+    The transformation is based on the BOSS `Helix::pivot` method, and is done per
+    track by the `_helix_change_pivot` kernels.
 
     This method will be called by the `change_pivot` method of `HelixObject`, `HelixAwkwardRecord` and `HelixAwkwardArray`.
 
@@ -113,67 +114,25 @@ def _change_pivot(
     Returns:
         A tuple containing the new dr, new phi0, new dz, and the transformed error matrix (if available).
     """
-    if isinstance(old_pivot, vector.VectorObject3D):
-        old_dist = vector.obj(rho=old_dr + r, phi=old_phi0)
-    elif isinstance(old_pivot, vector.VectorNumpy3D):
-        old_dist = vector.arr({"rho": old_dr + r, "phi": old_phi0})
-    else:
-        raise TypeError(f"Unsupported old_pivot type: {type(old_pivot)}. ")
-
-    center = old_pivot.to_2D() + old_dist
-
-    new_dist: vector.Vector2D = center - new_pivot.to_2D()
-
-    new_dr = new_dist.rho - r
-    new_phi0 = new_dist.phi % (2 * np.pi)
-
-    if isinstance(new_phi0, np.ndarray):
-        dphi = np.unwrap(new_phi0 - old_phi0)
-    else:
-        dphi = (new_phi0 - old_phi0) % (2 * np.pi)
-        if dphi > np.pi:
-            dphi -= 2 * np.pi
-    new_dz = old_pivot.z + old_dz - r * tanl * dphi - new_pivot.z
+    pivots = (
+        old_pivot.x,
+        old_pivot.y,
+        old_pivot.z,
+        new_pivot.x,
+        new_pivot.y,
+        new_pivot.z,
+    )
 
-    # transform error matrix
+    # the error matrix is transformed with J @ C @ J.T in the same pass
     if old_error is not None:
-        cos_dphi = np.cos(dphi)
-        sin_dphi = np.sin(dphi)
-
-        rdr = r + old_dr
-        rdrpr = 1 / (r + new_dr)
-
-        jacobian: np.ndarray = np.zeros_like(old_error)  # (tracks, i, j)
-        if jacobian.ndim == 3:
-            jacobian = jacobian.transpose(1, 2, 0)  # (i, j, tracks)
-
-        jacobian[0, 0] = cos_dphi
-        jacobian[0, 1] = rdr * sin_dphi
-        jacobian[0, 2] = r / kappa * (1 - cos_dphi)
-
-        jacobian[1, 0] = -rdrpr * sin_dphi
-        jacobian[1, 1] = rdr * rdrpr * cos_dphi
-        jacobian[1, 2] = r / kappa * rdrpr * sin_dphi
-
-        jacobian[2, 2] = 1
-
-        jacobian[3, 0] = r * rdrpr * tanl * sin_dphi
-        jacobian[3, 1] = r * tanl * (1 - rdr * rdrpr * cos_dphi)
-        jacobian[3, 2] = r / kappa * tanl * (dphi - r * rdrpr * sin_dphi)
-        jacobian[3, 3] = 1
-        jacobian[3, 4] = -r * dphi
-
-        jacobian[4, 4] = 1
-
-        if jacobian.ndim == 3:
-            jacobian = jacobian.transpose(2, 0, 1)  # (tracks, i, j)
-            new_error = jacobian @ old_error @ jacobian.transpose(0, 2, 1)
-        else:
-            new_error = jacobian @ old_error @ jacobian.T
-    else:
-        new_error = None
+        return _ufuncs._helix_change_pivot_error(
+            r, old_dr, old_phi0, old_dz, kappa, tanl, *pivots, old_error
+        )
 
-    return new_dr, new_phi0, new_dz, new_error
+    new_dr, new_phi0, new_dz = _ufuncs._helix_change_pivot(
+        r, old_dr, old_phi0, old_dz, tanl, *pivots
+    )
+    return new_dr, new_phi0, new_dz, None
 
 
 def _obj_isclose(self, other, *, rtol: float, atol: float, equal_nan: bool) -> bool:
@@ -333,6 +292,47 @@ class HelixObject:
             pivot=new_pivot,
         )
 
+    def extrapolate_to_cylinder(
+        self, radius: float
+    ) -> tuple[vector.VectorObject3D, vector.MomentumObject3D, float, bool]:
+        """
+        Extrapolate the helix to the cylinder `x^2 + y^2 = radius^2`, returning the first
+        intersection along the flight direction within one turn.
+
+        Parameters:
+            radius: Radius of the cylinder in cm.
+
+        Returns:
+            Tuple of position and momentum at the intersection, path length from the point
+                closest to the pivot, and whether the cylinder is reached. Position, momentum
+                and path length are `NaN` if the cylinder is not reached.
+        """
+        return self._extrapolate(_ufuncs.helix_to_cylinder, radius)
+
+    def extrapolate_to_z_plane(
+        self, z_plane: float
+    ) -> tuple[vector.VectorObject3D, vector.MomentumObject3D, float, bool]:
+        """
+        Extrapolate the helix to the plane `z = z_plane`.
+
+        Parameters:
+            z_plane: z position of the plane in cm.
+
+        Returns:
+            Tuple of position and momentum at the intersection, path length from the point
+                closest to the pivot, and whether the plane is reached. Position, momentum
+                and path length are `NaN` if the plane is not reached.
+        """
+        return self._extrapolate(_ufuncs.helix_to_z_plane, z_plane)
+
+    def _extrapolate(self, kernel, value):
+        (x, y, z), (px, py, pz), path_length, reached = _compute_extrapolation(
+            self, kernel, value
+        )
+        position = vector.obj(x=float(x), y=float(y), z=float(z))
+        momentum = vector.obj(px=float(px), py=float(py), pz=float(pz))
+        return position, momentum, float(path_length), bool(reached)
+
     def __repr__(self) -> str:
         return f"Bes3Helix(dr={self.dr:.3f}, phi0={self.phi0:.3f}, kappa={self.kappa:.3f}, tanl={self.tanl:.3f}, dz={self.dz:.3f})"
 
@@ -550,22 +550,69 @@ def kappa_to_radius(kappa: FloatLike) -> FloatLike:
     return _ufuncs.kappa_to_radius(kappa)
 
 
+def helix_kinematics(
+    dr: FloatLike,
+    phi0: FloatLike,
+    kappa: FloatLike,
+    dz: FloatLike,
+    tanl: FloatLike,
+) -> tuple[FloatLike, FloatLike, FloatLike, FloatLike, FloatLike, FloatLike, IntLike]:
+    """
+    Convert helix parameters to momentum, position and charge in a single pass.
+
+    This is equivalent to calling `kappa_to_pt`, `phi0_to_phi`, `dr_phi0_to_x`,
+    `dr_phi0_to_y` and `kappa_to_charge` separately, but `phi0` is only read once and
+    its sine and cosine are only computed once.
+
+    Parameters:
+        dr: helix[0] parameter, dr.
+        phi0: helix[1] parameter, phi0.
+        kappa: helix[2] parameter, kappa.
+        dz: helix[3] parameter, dz.
+        tanl: helix[4] parameter, tanl.
+
+    Returns:
+        Tuple of `pt`, `phi`, `pz`, `x`, `y`, `z` and `charge`, evaluated at the point
+            closest to the pivot.
+    """
+    return _apply_jagged(_ufuncs.helix_kinematics, dr, phi0, kappa, dz, tanl)
+
+
 ###############################################################################################
 
 
-def _compute_momentum(kappa, tanl, phi0):
-    pt = kappa_to_pt(kappa)
-    pz = pt * tanl
-    phi = phi0_to_phi(phi0)
-    return pt, phi, pz
+def _compute_momentum(helix):
+    return _apply_jagged(_ufuncs._helix_momentum, helix.kappa, helix.phi0, helix.tanl)
 
 
-def _compute_position(dr, phi0, dz):
-    x = dr_phi0_to_x(dr, phi0)
-    y = dr_phi0_to_y(dr, phi0)
-    z = dz
+def _compute_position(helix):
+    return _apply_jagged(_ufuncs._helix_position, helix.dr, helix.phi0, helix.dz)
 
-    return x, y, z
+
+def _compute_extrapolation(helix, kernel, value):
+    pivot = helix.pivot
+    x, y, z, path_length, px, py, pz, reached = _apply_jagged(
+        kernel,
+        helix.dr,
+        helix.phi0,
+        helix.kappa,
+        helix.dz,
+        helix.tanl,
+        pivot.x,
+        pivot.y,
+        pivot.z,
+        value,
+    )
+    return (x, y, z), (px, py, pz), path_length, reached
+
+
+def _awk_extrapolate(helix, kernel, value):
+    (x, y, z), (px, py, pz), path_length, reached = _compute_extrapolation(
+        helix, kernel, value
+    )
+    position = ak.zip({"x": x, "y": y, "z": z}, with_name="Vector3D")
+    momentum = ak.zip({"px": px, "py": py, "pz": pz}, with_name="Momentum3D")
+    return position, momentum, path_length, reached
 
 
 ###############################################################################################
@@ -719,7 +766,7 @@ class HelixAwkwardRecord(ak.Record):
         Returns:
             vector.MomentumObject3D: The momentum vector of the helix.
         """
-        pt, phi, pz = _compute_momentum(self.kappa, self.tanl, self.phi0)
+        pt, phi, pz = _compute_momentum(self)
         return ak.zip({"pt": pt, "phi": phi, "pz": pz}, with_name="Momentum3D")
 
     @property
@@ -730,7 +777,7 @@ class HelixAwkwardRecord(ak.Record):
         Returns:
             vector.VectorObject3D: The position vector of the helix.
         """
-        x, y, z = _compute_position(self.dr, self.phi0, self.dz)
+        x, y, z = _compute_position(self)
         return ak.zip({"x": x, "y": y, "z": z}, with_name="Vector3D")
 
     @property
@@ -753,6 +800,39 @@ class HelixAwkwardRecord(ak.Record):
         """
         return kappa_to_radius(self.kappa)
 
+    def extrapolate_to_cylinder(
+        self, radius: float
+    ) -> tuple[vec_ak.VectorAwkward3D, vec_ak.MomentumAwkward3D, ak.Array, ak.Array]:
+        """
+        Extrapolate the helix to the cylinder `x^2 + y^2 = radius^2`, returning the first
+        intersection along the flight direction within one turn.
+
+        Parameters:
+            radius: Radius of the cylinder in cm.
+
+        Returns:
+            Tuple of position and momentum at the intersection, path length from the point
+                closest to the pivot, and whether the cylinder is reached. Position, momentum
+                and path length are `NaN` if the cylinder is not reached.
+        """
+        return _awk_extrapolate(self, _ufuncs.helix_to_cylinder, radius)
+
+    def extrapolate_to_z_plane(
+        self, z_plane: float
+    ) -> tuple[vec_ak.VectorAwkward3D, vec_ak.MomentumAwkward3D, ak.Array, ak.Array]:
+        """
+        Extrapolate the helix to the plane `z = z_plane`.
+
+        Parameters:
+            z_plane: z position of the plane in cm.
+
+        Returns:
+            Tuple of position and momentum at the intersection, path length from the point
+                closest to the pivot, and whether the plane is reached. Position, momentum
+                and path length are `NaN` if the plane is not reached.
+        """
+        return _awk_extrapolate(self, _ufuncs.helix_to_z_plane, z_plane)
+
     def change_pivot(self, *args) -> HelixAwkwardRecord:
         multi_trk = isinstance(self.pivot.x, ak.Array)
         res_dict, raw_shape = _awk_change_pivot(self, args, is_multi_trk=multi_trk)
@@ -801,7 +881,7 @@ class HelixAwkwardArray(ak.Array):
         Returns:
             vector.MomentumNumpy3D: The momentum vectors of the helix.
         """
-        pt, phi, pz = _compute_momentum(self.kappa, self.tanl, self.phi0)
+        pt, phi, pz = _compute_momentum(self)
         return ak.zip({"pt": pt, "phi": phi, "pz": pz}, with_name="Momentum3D")
 
     @property
@@ -812,7 +892,7 @@ class HelixAwkwardArray(ak.Array):
         Returns:
             vector.VectorNumpy3D: The position vectors of the helix.
         """
-        x, y, z = _compute_position(self.dr, self.phi0, self.dz)
+        x, y, z = _compute_position(self)
         return ak.zip({"x": x, "y": y, "z": z}, with_name="Vector3D")
 
     @property
@@ -835,6 +915,41 @@ class HelixAwkwardArray(ak.Array):
         """
         return kappa_to_radius(self.kappa)
 
+    def extrapolate_to_cylinder(
+        self, radius: FloatLike
+    ) -> tuple[vec_ak.VectorAwkward3D, vec_ak.MomentumAwkward3D, ak.Array, ak.Array]:
+        """
+        Extrapolate the helix to the cylinder `x^2 + y^2 = radius^2`, returning the first
+        intersection along the flight direction within one turn.
+
+        Parameters:
+            radius: Radius of the cylinder in cm, either a scalar or an array of
+                the same structure as the helix array.
+
+        Returns:
+            Tuple of position and momentum at the intersection, path length from the point
+                closest to the pivot, and whether the cylinder is reached. Position, momentum
+                and path length are `NaN` if the cylinder is not reached.
+        """
+        return _awk_extrapolate(self, _ufuncs.helix_to_cylinder, radius)
+
+    def extrapolate_to_z_plane(
+        self, z_plane: FloatLike
+    ) -> tuple[vec_ak.VectorAwkward3D, vec_ak.MomentumAwkward3D, ak.Array, ak.Array]:
+        """
+        Extrapolate the helix to the plane `z = z_plane`.
+
+        Parameters:
+            z_plane: z position of the plane in cm, either a scalar or an array of the
+                same structure as the helix array.
+
+        Returns:
+            Tuple of position and momentum at the intersection, path length from the point
+                closest to the pivot, and whether the plane is reached. Position, momentum
+                and path length are `NaN` if the plane is not reached.
+        """
+        return _awk_extrapolate(self, _ufuncs.helix_to_z_plane, z_plane)
+
     def change_pivot(self, *args) -> HelixAwkwardArray:
         """
         Changes the pivot point of the helix.
@@ -4,10 +4,7 @@ import awkward as ak
 import numpy as np
 
 import pybes3.kernels.ufuncs as _ufuncs
-from pybes3.cgem import get_cgem_gid
-from pybes3.emc import get_emc_gid
-from pybes3.mdc import get_mdc_gid
-from pybes3.tof import get_tof_gid
+from pybes3._utils import _apply_jagged
 from pybes3.typing import BoolLike, IntLike
 
 
@@ -98,9 +95,9 @@ def mdc_id_to_gid(mdc_id: IntLike) -> IntLike:
         mdc_id: The MDC digi ID array or value.
 
     Returns:
-        The wire global ID.
+        The wire global ID, or -1 if the digi ID is not a valid MDC wire ID.
     """
-    return get_mdc_gid(mdc_id_to_layer(mdc_id), mdc_id_to_wire(mdc_id))
+    return _ufuncs.mdc_id_to_gid(mdc_id)
 
 
 def parse_mdc_id(mdc_id: IntLike) -> ak.Array | dict[str, np.ndarray | int]:
@@ -121,11 +118,13 @@ def parse_mdc_id(mdc_id: IntLike) -> ak.Array | dict[str, np.ndarray | int]:
         The parsed MDC digi ID.
     """
 
+    layer, wire, is_stereo = _apply_jagged(_ufuncs.parse_mdc_id, mdc_id)
+
     res = {
-        "gid": mdc_id_to_gid(mdc_id),
-        "layer": mdc_id_to_layer(mdc_id),
-        "wire": mdc_id_to_wire(mdc_id),
-        "is_stereo": mdc_id_to_is_stereo(mdc_id),
+        "gid": _apply_jagged(_ufuncs.mdc_id_to_gid, mdc_id),
+        "layer": layer,
+        "wire": wire,
+        "is_stereo": is_stereo,
     }
 
     if isinstance(mdc_id, ak.Array):
@@ -361,14 +360,9 @@ def tof_id_to_gid(tof_id: IntLike) -> IntLike:
         tof_id: The TOF digi ID array or value.
 
     Returns:
-        The strip global ID.
+        The strip global ID, or -1 if the digi ID is not a valid TOF strip ID.
     """
-    part = tof_id_to_part(tof_id)
-    return get_tof_gid(
-        part,
-        tof_id_to_layer_or_module(tof_id, part),
-        tof_id_to_phi_or_strip(tof_id, part),
-    )
+    return _ufuncs.tof_id_to_gid(tof_id)
 
 
 def parse_tof_id(tof_id: IntLike) -> ak.Array | dict[str, np.ndarray | int]:
@@ -397,11 +391,8 @@ def parse_tof_id(tof_id: IntLike) -> ak.Array | dict[str, np.ndarray | int]:
 
     """
 
-    part = tof_id_to_part(tof_id)
-    layer_or_module = tof_id_to_layer_or_module(tof_id, part)
-    phi_or_strip = tof_id_to_phi_or_strip(tof_id, part)
-    end = tof_id_to_end(tof_id)
-    gid = get_tof_gid(part, layer_or_module, phi_or_strip)
+    part, layer_or_module, phi_or_strip, end = _apply_jagged(_ufuncs.parse_tof_id, tof_id)
+    gid = _apply_jagged(_ufuncs.tof_id_to_gid, tof_id)
 
     res = {
         "gid": gid,
@@ -545,11 +536,9 @@ def emc_id_to_gid(emc_id: IntLike) -> IntLike:
         emc_id: The EMC digi ID array or value.
 
     Returns:
-        The crystal global ID.
+        The crystal global ID, or -1 if the digi ID is not a valid EMC crystal ID.
     """
-    return get_emc_gid(
-        emc_id_to_module(emc_id), emc_id_to_theta(emc_id), emc_id_to_phi(emc_id)
-    )
+    return _ufuncs.emc_id_to_gid(emc_id)
 
 
 def parse_emc_id(emc_id: IntLike) -> ak.Array | dict[str, np.ndarray | int]:
@@ -569,11 +558,9 @@ def parse_emc_id(emc_id: IntLike) -> ak.Array | dict[str, np.ndarray | int]:
     Returns:
         The parsed EMC digi ID.
     """
-    module = emc_id_to_module(emc_id)
-    theta = emc_id_to_theta(emc_id)
-    phi = emc_id_to_phi(emc_id)
+    module, theta, phi = _apply_jagged(_ufuncs.parse_emc_id, emc_id)
     res = {
-        "gid": get_emc_gid(module, theta, phi),
+        "gid": _apply_jagged(_ufuncs.emc_id_to_gid, emc_id),
         "part": module,
         "theta": theta,
         "phi": phi,
@@ -745,12 +732,26 @@ def muc_id_to_strip(muc_id: IntLike) -> IntLike:
     return muc_id_to_channel(muc_id)
 
 
+def muc_id_to_gid(muc_id: IntLike) -> IntLike:
+    """
+    Convert MUC digi ID to strip global ID (gid).
+
+    Parameters:
+        muc_id: The MUC digi ID array or value.
+
+    Returns:
+        The strip global ID, or -1 if the digi ID is not a valid MUC strip ID.
+    """
+    return _ufuncs.muc_id_to_gid(muc_id)
+
+
 def parse_muc_id(muc_id: IntLike) -> ak.Array | dict[str, np.ndarray | int]:
     """
     Parse MUC digi ID.
 
     Available keys of the output:
 
+    - `gid`: Global ID of the strip, -1 if the digi ID is out of range.
     - `part`: The part number.
     - `segment`: The segment number.
     - `layer`: The layer number.
@@ -764,12 +765,10 @@ def parse_muc_id(muc_id: IntLike) -> ak.Array | dict[str, np.ndarray | int]:
     Returns:
         The parsed MUC digi ID.
     """
-    part = muc_id_to_part(muc_id)
-    segment = muc_id_to_segment(muc_id)
-    layer = muc_id_to_layer(muc_id)
-    channel = muc_id_to_channel(muc_id)
+    part, segment, layer, channel = _apply_jagged(_ufuncs.parse_muc_id, muc_id)
 
     res = {
+        "gid": _apply_jagged(_ufuncs.muc_id_to_gid, muc_id),
         "part": part,
         "segment": segment,
         "layer": layer,
@@ -880,14 +879,9 @@ def cgem_id_to_gid(cgem_id: IntLike) -> IntLike:
         cgem_id: The CGEM digi ID array or value.
 
     Returns:
-        The strip global ID.
+        The strip global ID, or -1 if the digi ID is not a valid CGEM strip ID.
     """
-    return get_cgem_gid(
-        cgem_id_to_layer(cgem_id),
-        cgem_id_to_sheet(cgem_id),
-        cgem_id_to_strip_type(cgem_id),
-        cgem_id_to_strip(cgem_id),
-    )
+    return _ufuncs.cgem_id_to_gid(cgem_id)
 
 
 def parse_cgem_id(cgem_id: IntLike) -> ak.Array | dict[str, np.ndarray | int]:
@@ -908,11 +902,8 @@ def parse_cgem_id(cgem_id: IntLike) -> ak.Array | dict[str, np.ndarray | int]:
     Returns:
         The parsed CGEM digi ID.
     """
-    layer = cgem_id_to_layer(cgem_id)
-    sheet = cgem_id_to_sheet(cgem_id)
-    strip_type = cgem_id_to_strip_type(cgem_id)
-    strip = cgem_id_to_strip(cgem_id)
-    gid = get_cgem_gid(layer, sheet, strip_type, strip)
+    layer, sheet, strip_type, strip = _apply_jagged(_ufuncs.parse_cgem_id, cgem_id)
+    gid = _apply_jagged(_ufuncs.cgem_id_to_gid, cgem_id)
 
     res = {
         "gid": gid,
@@ -975,3 +966,61 @@ def parse_cgem_digi(
         return ak.zip(res)
     else:
         return res
+
+
+###############################################################################
+#                               Mixed detectors                               #
+###############################################################################
+DIGI_DETECTOR_UNKNOWN = -1
+DIGI_DETECTOR_MDC = 0
+DIGI_DETECTOR_TOF = 1
+DIGI_DETECTOR_EMC = 2
+DIGI_DETECTOR_MUC = 3
+DIGI_DETECTOR_CGEM = 4
+
+
+def decode_digi_id(digi_id: IntLike) -> ak.Array | dict[str, np.ndarray | int]:
+    """
+    Decode digi IDs of any detector in one pass, e.g. for mixed ID streams of MC truth
+    hits. The detector is read from the flag byte of each ID.
+
+    Available keys of the output:
+
+    - `detector`: The detector code, `DIGI_DETECTOR_MDC` (0), `DIGI_DETECTOR_TOF` (1),
+        `DIGI_DETECTOR_EMC` (2), `DIGI_DETECTOR_MUC` (3), `DIGI_DETECTOR_CGEM` (4), or
+        `DIGI_DETECTOR_UNKNOWN` (-1).
+    - `gid`: Global ID of the channel in its detector, the same as `xxx_id_to_gid`. It is
+        `-1` for unknown detectors or IDs of none of the channels of the detector.
+    - `field0` to `field3`: The fields of `parse_xxx_id` of the detector, `-1` if unused:
+
+    | Detector | `field0` | `field1`          | `field2`       | `field3` |
+    | -------- | -------- | ----------------- | -------------- | -------- |
+    | MDC      | layer    | wire              | is_stereo      | -1       |
+    | TOF      | part     | layer_or_module   | phi_or_strip   | end      |
+    | EMC      | part     | theta             | phi            | -1       |
+    | MUC      | part     | segment           | gap            | strip    |
+    | CGEM     | layer    | sheet             | strip_type     | strip    |
+
+    Parameters:
+        digi_id: The digi ID array or value.
+
+    Returns:
+        The decoded digi ID.
+    """
+    detector, gid, field0, field1, field2, field3 = _apply_jagged(
+        _ufuncs.decode_digi_id, digi_id
+    )
+
+    res = {
+        "detector": detector,
+        "gid": gid,
+        "field0": field0,
+        "field1": field1,
+        "field2": field2,
+        "field3": field3,
+    }
+
+    if isinstance(digi_id, ak.Array):
+        return ak.zip(res)
+    else:
+        return res
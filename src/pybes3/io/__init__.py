@@ -1,11 +1,13 @@
 from __future__ import annotations
 
+from collections.abc import MutableMapping
 from typing import Any
 from warnings import warn
 
 import uproot
 
 from pybes3.io import root_io  # noqa: F401
+from pybes3.io.cache import DiskArrayCache
 from pybes3.io.raw_io import RawBinaryReader
 from pybes3.io.raw_io import concatenate as concatenate_raw
 
@@ -57,17 +59,18 @@ def concatenate(
     return uproot.concatenate(files, expressions, cut, **kwargs)
 
 
-def open_raw(file: str) -> RawBinaryReader:
+def open_raw(file: str, array_cache: MutableMapping | None = None) -> RawBinaryReader:
     """
     Open a raw binary file.
 
     Parameters:
         file (str): The file to open.
+        array_cache (MutableMapping | None): Cache of decoded arrays, e.g. `DiskArrayCache`.
 
     Returns:
         (RawBinaryReader): The raw binary reader.
     """
-    return RawBinaryReader(file)
+    return RawBinaryReader(file, array_cache=array_cache)
 
 
-__all__ = ["concatenate", "concatenate_raw", "open", "open_raw"]
+__all__ = ["DiskArrayCache", "concatenate", "concatenate_raw", "open", "open_raw"]
@@ -0,0 +1,169 @@
+from __future__ import annotations
+
+import hashlib
+import json
+import mmap
+import os
+import shutil
+import threading
+from collections.abc import Iterable, Iterator, MutableMapping
+from pathlib import Path
+
+import awkward as ak
+import numpy as np
+
+from pybes3._version import __version__
+
+_ALIGNMENT = 64
+
+# Bump when the layout of the cache entries changes
+_FORMAT_VERSION = 1
+
+
+def _default_cache_dir() -> Path:
+    env_dir = os.environ.get("PYBES3_CACHE_DIR")
+    if env_dir:
+        return Path(env_dir)
+    return Path.home() / ".cache" / "pybes3"
+
+
+def _write_atomic(path: Path, chunks: Iterable[bytes | np.ndarray]) -> None:
+    tmp_path = path.with_name(f"{path.name}.{os.getpid()}.{threading.get_ident()}.tmp")
+    with open(tmp_path, "wb") as f:
+        f.writelines(chunks)
+    os.replace(tmp_path, path)
+
+
+def _map_file(path: Path) -> np.ndarray:
+    # The file is closed right away, the mapping is released with the last array viewing it
+    with open(path, "rb") as f:
+        return np.frombuffer(mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ), dtype=np.uint8)
+
+
+class DiskArrayCache(MutableMapping):
+    """
+    Persistent cache of decoded awkward arrays on local disk.
+
+    Each array is stored as its flat buffers plus the awkward form, and is read back
+    with `ak.from_buffers` on top of a memory-mapped file, so cache hits cost almost
+    nothing. Values that are not `ak.Array` are silently not cached.
+
+    Entries are keyed with the `pybes3` version, so that arrays decoded by another
+    release are never served. The cached files are mapped read-only, and each mapping is
+    released once the arrays read from it are garbage collected.
+
+    It can be passed to `uproot.open` as `array_cache`, in which case entries are keyed
+    by uproot with the file UUID, branch path, interpretation and entry range:
+
+    ```python
+    >>> cache = pybes3.io.DiskArrayCache("/path/to/cache")
+    >>> f = uproot.open("test.dst", array_cache=cache)
+    ```
+
+    and to `pybes3.open_raw` / `pybes3.concatenate_raw` for raw data files.
+
+    Parameters:
+        directory (str | Path | None): The cache directory. Defaults to the
+            `PYBES3_CACHE_DIR` environment variable, or `~/.cache/pybes3`.
+    """
+
+    def __init__(self, directory: str | Path | None = None):
+        if directory is None:
+            directory = _default_cache_dir()
+
+        self.directory = Path(directory).expanduser().resolve()
+        self.directory.mkdir(parents=True, exist_ok=True)
+        self.lock = threading.RLock()
+
+    def _entry_dir(self, key: str) -> Path:
+        versioned_key = f"{__version__}\0{_FORMAT_VERSION}\0{key}"
+        return self.directory / hashlib.sha256(versioned_key.encode()).hexdigest()
+
+    def _read_meta(self, entry_dir: Path) -> dict | None:
+        try:
+            meta = json.loads((entry_dir / "meta.json").read_text())
+        except (FileNotFoundError, NotADirectoryError, json.JSONDecodeError):
+            return None
+
+        # entries of other releases are left for `clear`
+        if meta.get("version") != __version__ or meta.get("format") != _FORMAT_VERSION:
+            return None
+        return meta
+
+    def __getitem__(self, key: str) -> ak.Array:
+        entry_dir = self._entry_dir(key)
+        meta = self._read_meta(entry_dir)
+        if meta is None or meta["key"] != key:
+            raise KeyError(key)
+
+        if meta["nbytes"] > 0:
+            buffer = _map_file(entry_dir / "buffers.bin")
+        else:
+            buffer = np.empty(0, dtype=np.uint8)
+
+        container = {
+            name: buffer[start:stop] for name, (start, stop) in meta["buffers"].items()
+        }
+        return ak.from_buffers(meta["form"], meta["length"], container)
+
+    def __setitem__(self, key: str, value: object) -> None:
+        if not isinstance(value, ak.Array):
+            return
+
+        form, length, container = ak.to_buffers(value)
+
+        buffers = {}
+        chunks = []
+        nbytes = 0
+        for name, arr in container.items():
+            raw = np.ascontiguousarray(arr).view(np.uint8).reshape(-1)
+            buffers[name] = (nbytes, nbytes + raw.size)
+            chunks.append(raw)
+
+            padding = -raw.size % _ALIGNMENT
+            if padding:
+                chunks.append(np.zeros(padding, dtype=np.uint8))
+            nbytes += raw.size + padding
+
+        meta = {
+            "version": __version__,
+            "format": _FORMAT_VERSION,
+            "key": key,
+            "form": form.to_json(),
+            "length": length,
+            "nbytes": nbytes,
+            "buffers": buffers,
+        }
+
+        entry_dir = self._entry_dir(key)
+        with self.lock:
+            entry_dir.mkdir(parents=True, exist_ok=True)
+            # meta.json is written last, it marks the entry as complete
+            _write_atomic(entry_dir / "buffers.bin", chunks)
+            _write_atomic(entry_dir / "meta.json", [json.dumps(meta).encode()])
+
+    def __delitem__(self, key: str) -> None:
+        entry_dir = self._entry_dir(key)
+        if self._read_meta(entry_dir) is None:
+            raise KeyError(key)
+
+        with self.lock:
+            shutil.rmtree(entry_dir, ignore_errors=True)
+
+    def __iter__(self) -> Iterator[str]:
+        for entry_dir in self.directory.iterdir():
+            meta = self._read_meta(entry_dir)
+            if meta is not None:
+                yield meta["key"]
+
+    def __len__(self) -> int:
+        return sum(1 for _ in self)
+
+    def clear(self) -> None:
+        with self.lock:
+            for entry_dir in self.directory.iterdir():
+                if entry_dir.is_dir():
+                    shutil.rmtree(entry_dir, ignore_errors=True)
+
+    def __repr__(self) -> str:
+        return f"<DiskArrayCache directory='{self.directory}'>"
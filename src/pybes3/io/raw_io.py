@@ -2,6 +2,8 @@ from __future__ import annotations
 
 import enum
 import glob
+import os
+from collections.abc import MutableMapping
 from pathlib import Path
 
 import awkward as ak
@@ -60,7 +62,7 @@ def _raw_dict_to_ak(raw_dict: dict[str, object]) -> ak.Array:
         elif field_name in ["cgem", "mdc", "tof", "emc", "muc", "trigGTD"]:
             offsets, data_dict = org_data
             contents[field_name] = awkward.contents.ListOffsetArray(
-                awkward.index.Index(offsets),
+                awkward.index.Index64(offsets),
                 awkward.contents.RecordArray(
                     [awkward.contents.NumpyArray(i) for i in data_dict.values()],
                     list(data_dict.keys()),
@@ -69,7 +71,7 @@ def _raw_dict_to_ak(raw_dict: dict[str, object]) -> ak.Array:
         else:
             offsets, data = org_data
             contents[field_name] = awkward.contents.ListOffsetArray(
-                awkward.index.Index(offsets),
+                awkward.index.Index64(offsets),
                 awkward.contents.NumpyArray(data),
             )
 
@@ -77,7 +79,7 @@ def _raw_dict_to_ak(raw_dict: dict[str, object]) -> ak.Array:
 
 
 class RawBinaryReader:
-    def __init__(self, file: str):
+    def __init__(self, file: str, array_cache: MutableMapping | None = None):
         # load cgem-elec-table
         global _info_tables
         if _info_tables is None:
@@ -98,6 +100,11 @@ class RawBinaryReader:
         self.path = str(Path(file).resolve())
         self._file = open(file, "rb")  # noqa: SIM115
 
+        # file identity used as prefix of array cache keys
+        self.array_cache = array_cache
+        stat = os.stat(self.path)
+        self.cache_key = f"{self.path}:{stat.st_size}:{stat.st_mtime_ns}"
+
         self.file_version: int = -1
         self.file_number: int = -1
         self.file_date: int = -1
@@ -156,10 +163,21 @@ class RawBinaryReader:
         filter_func = regularize_filter(filter_name)
         fields = [field for field in _RAW_FIELDS if filter_func(field)]
 
+        if self.array_cache is not None:
+            cache_key = f"{self.cache_key}:{entry_start}-{entry_stop}:{','.join(fields)}"
+            cached = self.array_cache.get(cache_key)
+            if cached is not None:
+                return cached
+
         batch_data = self._read_event(entry_start, entry_stop)
 
         org_dict = read_bes_raw(batch_data, fields, _info_tables)
-        return _raw_dict_to_ak(org_dict)
+        res = _raw_dict_to_ak(org_dict)
+
+        if self.array_cache is not None:
+            self.array_cache[cache_key] = res
+
+        return res
 
     def _read(self) -> int:
         return int.from_bytes(self._file.read(4), "little")
@@ -353,6 +371,7 @@ def concatenate(
     entry_stop: int = -1,
     filter_name: str | list | None = None,
     verbose: bool = False,
+    array_cache: MutableMapping | None = None,
 ) -> ak.Array:
     """
     Concatenate multiple raw binary files into `ak.Array`
@@ -363,6 +382,7 @@ def concatenate(
         entry_stop (int, optional): The stopping entry to read. Defaults to -1, which means read until the end.
         filter_name (Union[str, list, None], optional): A filter to select specific fields to read. Defaults to `None`, which means read all fields.
         verbose (bool, optional): Show reading process. Defaults to `False`.
+        array_cache (MutableMapping | None, optional): Cache of decoded arrays, e.g. `pybes3.io.DiskArrayCache`. Defaults to `None`.
 
     Returns:
         Concatenated raw data array.
@@ -378,7 +398,7 @@ def concatenate(
     n_cum_entries = 0
     readers_with_entry_range: list[tuple[RawBinaryReader, int, int]] = []
     for file in files:
-        reader = RawBinaryReader(file)
+        reader = RawBinaryReader(file, array_cache=array_cache)
 
         if n_cum_entries + reader.entries < entry_start:
             n_cum_entries += reader.entries
@@ -9,8 +9,10 @@ import awkward.index
 import numpy as np
 import uproot
 import uproot.behaviors.TBranch
+import uproot.compression
 import uproot.extras
 import uproot.interpretation
+import uproot.source.chunk
 import uproot_custom.readers.cpp
 import uproot_custom.readers.python
 from uproot_custom import (
@@ -78,7 +80,7 @@ class Bes3PyTObjArrayReader(uproot_custom.readers.python.IReader):
     def __init__(self, name, element_reader: uproot_custom.readers.python.IReader):
         super().__init__(name)
         self.element_reader = element_reader
-        self.offsets = array.array("I", [0])
+        self.offsets = array.array("q", [0])
 
     def read(self, stream):
         stream.skip_fNBytes()
@@ -221,7 +223,7 @@ class Bes3PyCgemClusterColReader(uproot_custom.readers.python.IReader):
 
         self.version = -1  # -1: unknown, 0: with recpositiony, 1: without recpositiony
 
-        self.offsets = array.array("I", [0])
+        self.offsets = array.array("q", [0])
         self.clusterid = array.array("i")
         self.trkid = array.array("i")
         self.layerid = array.array("i")
@@ -286,21 +288,21 @@ class Bes3PyCgemClusterColReader(uproot_custom.readers.python.IReader):
         result = {}
 
         result["offsets"] = np.asarray(self.offsets)
-        result["m_clusterID"] = np.asarray(self.clusterid)
-        result["m_trkID"] = np.asarray(self.trkid)
-        result["m_layerID"] = np.asarray(self.layerid)
-        result["m_sheetID"] = np.asarray(self.sheetid)
+        result["m_clusterid"] = np.asarray(self.clusterid)
+        result["m_trkid"] = np.asarray(self.trkid)
+        result["m_layerid"] = np.asarray(self.layerid)
+        result["m_sheetid"] = np.asarray(self.sheetid)
         result["m_flag"] = np.asarray(self.flag)
-        result["m_energyDeposit"] = np.asarray(self.energydeposit)
-        result["m_recPhi"] = np.asarray(self.recphi)
+        result["m_energydeposit"] = np.asarray(self.energydeposit)
+        result["m_recphi"] = np.asarray(self.recphi)
 
         if self.version == 0:
-            result["m_recPositionY"] = np.asarray(self.recpositiony)
+            result["m_recpositiony"] = np.asarray(self.recpositiony)
 
-        result["m_recV"] = np.asarray(self.recv)
+        result["m_recv"] = np.asarray(self.recv)
         result["m_recZ"] = np.asarray(self.recZ)
-        result["m_clusterFlag"] = np.asarray(self.clusterflag)
-        result["m_stripID"] = np.asarray(self.stripid)
+        result["m_clusterflag"] = np.asarray(self.clusterflag)
+        result["m_stripid"] = np.asarray(self.stripid)
 
         return result
 
@@ -341,10 +343,10 @@ class Bes3CgemClusterColFactory(Factory):
         for k, v in raw_data.items():
             tmp_content = awkward.contents.NumpyArray(v)
 
-            if k == "m_clusterFlag":
+            if k == "m_clusterflag":
                 tmp_content = awkward.contents.RegularArray(tmp_content, 2)
 
-            if k == "m_stripID":
+            if k == "m_stripid":
                 tmp_content = awkward.contents.RegularArray(tmp_content, 2)
                 tmp_content = awkward.contents.RegularArray(tmp_content, 2)
 
@@ -361,6 +363,95 @@ class Bes3CgemClusterColFactory(Factory):
         )
 
 
+class Bes3PyEvtNavigatorMapReader(uproot_custom.readers.python.IReader):
+    kStreamedMemberWise = 0x4000
+
+    def __init__(self, name: str):
+        super().__init__(name)
+        self.offsets = array.array("q", [0])
+        self.key = array.array("i")
+        self.val = array.array("i")
+
+    def read(self, stream):
+        stream.skip_fNBytes()
+        fVersion = stream.read_uint16()
+
+        is_memberwise = bool(fVersion & self.kStreamedMemberWise)
+        if is_memberwise:
+            stream.skip(6)  # class version + checksum
+
+        fSize = stream.read_uint32()
+        self.offsets.append(self.offsets[-1] + fSize)
+
+        if is_memberwise:
+            self.key.extend(stream.read_int32() for _ in range(fSize))
+            self.val.extend(stream.read_int32() for _ in range(fSize))
+        else:
+            for _ in range(fSize):
+                self.key.append(stream.read_int32())
+                self.val.append(stream.read_int32())
+
+    def data(self):
+        return np.asarray(self.offsets), np.asarray(self.key), np.asarray(self.val)
+
+
+class Bes3EvtNavigatorMapFactory(Factory):
+    """
+    Reads the `multimap<int, int>` MC-truth association maps of `TEvtNavigator`
+    into jagged `(key, val)` index pairs.
+    """
+
+    target_branches: ClassVar[set[str]] = {
+        "/Event:EventNavigator/m_mcMdcMcHits",
+        "/Event:EventNavigator/m_mcMdcTracks",
+        "/Event:EventNavigator/m_mcEmcMcHits",
+        "/Event:EventNavigator/m_mcEmcRecShowers",
+    }
+
+    @classmethod
+    def priority(cls):
+        return 50
+
+    @classmethod
+    def build_factory(
+        cls,
+        top_type_name: str,
+        cur_streamer_info: dict,
+        all_streamer_info: dict,
+        item_path: str,
+        **kwargs,
+    ):
+        if item_path.split(".")[0] not in cls.target_branches:
+            return None
+
+        return cls(name=cur_streamer_info["fName"])
+
+    def build_cpp_reader(self):
+        return bcpp.Bes3EvtNavigatorMapReader(self.name)
+
+    def build_python_reader(self):
+        return Bes3PyEvtNavigatorMapReader(self.name)
+
+    def make_awkward_content(self, raw_data):
+        offsets, key, val = raw_data
+        return awkward.contents.ListOffsetArray(
+            awkward.index.Index64(offsets),
+            awkward.contents.RecordArray(
+                [awkward.contents.NumpyArray(key), awkward.contents.NumpyArray(val)],
+                ["key", "val"],
+            ),
+        )
+
+    def make_awkward_form(self):
+        return awkward.forms.ListOffsetForm(
+            "i64",
+            awkward.forms.RecordForm(
+                [awkward.forms.NumpyForm("int32"), awkward.forms.NumpyForm("int32")],
+                ["key", "val"],
+            ),
+        )
+
+
 class Bes3PySymMatrixArrayReader(uproot_custom.readers.python.IReader):
     def __init__(self, name: str, flat_size: int, full_dim: int):
         super().__init__(name)
@@ -477,9 +568,69 @@ uproot_custom.registered_factories |= {
     Bes3SymMatrixArrayFactory,
     Bes3CgemClusterColFactory,
     Bes3BaseObjectFactory,
+    Bes3EvtNavigatorMapFactory,
 }
 
 
+##########################################################################################
+#                                   Native Decompression
+##########################################################################################
+_uproot_decompress = uproot.compression.decompress
+
+_compression_headers = {"ZLIB": b"ZL", "LZMA": b"XZ", "LZ4": b"L4", "ZSTD": b"ZS"}
+_native_headers = {_compression_headers[k] for k in bcpp.supported_compressions()}
+
+
+def _native_decompress(
+    chunk,
+    cursor,
+    context,
+    compressed_bytes,
+    uncompressed_bytes,
+    block_info=None,
+):
+    start = cursor.index
+    data = np.asarray(cursor.bytes(chunk, compressed_bytes, context), dtype=np.uint8)
+
+    if bytes(data[:2]) in _native_headers:
+        try:
+            output = bcpp.decompress(data, uncompressed_bytes)
+            return uproot.source.chunk.Chunk.wrap(chunk.source, output)
+        except RuntimeError:
+            pass  # e.g. mixed algorithms in one basket, let uproot handle it
+
+    cursor.move_to(start)
+    return _uproot_decompress(
+        chunk, cursor, context, compressed_bytes, uncompressed_bytes, block_info
+    )
+
+
+def enable_native_decompression(enable: bool = True) -> None:
+    """
+    Decompress baskets with the native `_io` kernels instead of uproot's Python codecs.
+
+    The native decompression runs with the GIL released, so baskets can be decompressed
+    in parallel with `decompression_executor`. Algorithms that are not compiled into
+    `_io` (see `native_decompression_algorithms`) fall back to uproot transparently.
+
+    Parameters:
+        enable (bool): Whether to enable native decompression.
+
+    Note:
+        When enabled, `TBasket.block_compression_info` is not filled for natively
+        decompressed baskets.
+    """
+    uproot.compression.decompress = _native_decompress if enable else _uproot_decompress
+
+
+def native_decompression_algorithms() -> list[str]:
+    """
+    Returns:
+        Names of compression algorithms supported by native decompression.
+    """
+    return list(bcpp.supported_compressions())
+
+
 ##########################################################################################
 #                                     Array Preprocess
 ##########################################################################################
@@ -10,7 +10,7 @@ class Bes3TObjArrayReader(IReader):
         name: str,
         element_reader: IReader,
     ): ...
-    def data(self) -> tuple[NDArray[np.uint32], Any]: ...
+    def data(self) -> tuple[NDArray[np.int64], Any]: ...
 
 class Bes3SymMatrixArrayReader(IReader):
     def __init__(
@@ -25,6 +25,10 @@ class Bes3CgemClusterColReader(IReader):
     def __init__(self, name: str): ...
     def data(self) -> dict[str, NDArray]: ...
 
+class Bes3EvtNavigatorMapReader(IReader):
+    def __init__(self, name: str): ...
+    def data(self) -> tuple[NDArray[np.int64], NDArray[np.int32], NDArray[np.int32]]: ...
+
 def read_data(
     data: NDArray[np.uint8],
     offsets: NDArray[np.uint32],
@@ -35,3 +39,8 @@ def read_bes_raw(
     fields: list[str],
     info_tables: dict[str, NDArray],
 ) -> dict: ...
+def supported_compressions() -> list[str]: ...
+def decompress(
+    data: NDArray[np.uint8],
+    uncompressed_bytes: int,
+) -> NDArray[np.uint8]: ...
@@ -3,12 +3,21 @@ from numpy._typing._ufunc import _UFunc_Nin1_Nout1, _UFunc_Nin2_Nout1
 
 # detectors/cgem.cc
 get_cgem_gid: np.ufunc
+cgem_id_to_gid: _UFunc_Nin1_Nout1
 cgem_gid_to_layer: _UFunc_Nin1_Nout1
 cgem_gid_to_sheet: _UFunc_Nin1_Nout1
 cgem_gid_to_strip_type: _UFunc_Nin1_Nout1
 cgem_gid_to_strip: _UFunc_Nin1_Nout1
 cgem_gid_to_is_xstrip: _UFunc_Nin1_Nout1
 cgem_gid_to_is_vstrip: _UFunc_Nin1_Nout1
+parse_cgem_gid: np.ufunc
+
+def _cgem_cluster_strips(
+    offsets: np.ndarray, gid: np.ndarray, charge: np.ndarray, max_gap: int, /
+) -> tuple[np.ndarray, ...]: ...
+def _cgem_xv_intersection(
+    offsets: np.ndarray, gid: np.ndarray, center: np.ndarray, geometry: np.ndarray, /
+) -> tuple[np.ndarray, ...]: ...
 
 # detectors/mdc.cc
 def _init_mdc_geom(
@@ -22,6 +31,7 @@ def _init_mdc_geom(
 ): ...
 
 get_mdc_gid: np.ufunc
+mdc_id_to_gid: _UFunc_Nin1_Nout1
 mdc_gid_to_superlayer: _UFunc_Nin1_Nout1
 mdc_layer_to_superlayer: _UFunc_Nin1_Nout1
 mdc_gid_to_layer: _UFunc_Nin1_Nout1
@@ -37,12 +47,40 @@ mdc_gid_to_east_y: _UFunc_Nin1_Nout1
 mdc_gid_to_east_z: _UFunc_Nin1_Nout1
 mdc_gid_z_to_x: _UFunc_Nin2_Nout1
 mdc_gid_z_to_y: _UFunc_Nin2_Nout1
+parse_mdc_gid: np.ufunc
+mdc_gid_to_geometry: np.ufunc
+mdc_layer_nearest_wire: np.ufunc
+mdc_helix_doca: np.ufunc
 
 # detectors/tof.cc
+def _init_tof_geom(
+    center_x: np.ndarray,
+    center_y: np.ndarray,
+    center_z: np.ndarray,
+    phi_min: np.ndarray,
+    phi_max: np.ndarray,
+    z_min: np.ndarray,
+    z_max: np.ndarray,
+    r_min: np.ndarray,
+    r_max: np.ndarray,
+    /,
+): ...
+
 get_tof_gid: np.ufunc
+tof_id_to_gid: _UFunc_Nin1_Nout1
 tof_gid_to_part: _UFunc_Nin1_Nout1
 tof_gid_to_layer_or_module: _UFunc_Nin1_Nout1
 tof_gid_to_phi_or_strip: _UFunc_Nin1_Nout1
+tof_gid_to_center_x: _UFunc_Nin1_Nout1
+tof_gid_to_center_y: _UFunc_Nin1_Nout1
+tof_gid_to_center_z: _UFunc_Nin1_Nout1
+tof_gid_to_phi_min: _UFunc_Nin1_Nout1
+tof_gid_to_phi_max: _UFunc_Nin1_Nout1
+tof_gid_to_z_min: _UFunc_Nin1_Nout1
+tof_gid_to_z_max: _UFunc_Nin1_Nout1
+tof_gid_to_r_min: _UFunc_Nin1_Nout1
+tof_gid_to_r_max: _UFunc_Nin1_Nout1
+parse_tof_gid: np.ufunc
 tof_hit_status_to_is_raw: _UFunc_Nin1_Nout1
 tof_hit_status_to_is_readout: _UFunc_Nin1_Nout1
 tof_hit_status_to_is_counter: _UFunc_Nin1_Nout1
@@ -57,6 +95,27 @@ tof_hit_status_to_n_east: _UFunc_Nin1_Nout1
 tof_hit_status_to_n_west: _UFunc_Nin1_Nout1
 tof_hit_status_to_is_mrpc: _UFunc_Nin1_Nout1
 
+def _tof_pair_ends(
+    offsets: np.ndarray,
+    gid: np.ndarray,
+    end: np.ndarray,
+    tdc: np.ndarray,
+    adc: np.ndarray,
+    overflow: np.ndarray,
+    params: np.ndarray,
+    /,
+) -> tuple[np.ndarray, ...]: ...
+def _tof_predict_counters(
+    x: np.ndarray,
+    y: np.ndarray,
+    z: np.ndarray,
+    k: int,
+    phi_tolerance: float,
+    z_tolerance: float,
+    r_tolerance: float,
+    /,
+) -> np.ndarray: ...
+
 # detectors/emc.cc
 def _init_emc_geom(
     points_x: np.ndarray,
@@ -72,6 +131,7 @@ def _init_emc_geom(
 ): ...
 
 get_emc_gid: np.ufunc
+emc_id_to_gid: _UFunc_Nin1_Nout1
 emc_gid_to_part: _UFunc_Nin1_Nout1
 emc_gid_to_theta: _UFunc_Nin1_Nout1
 emc_gid_to_phi: _UFunc_Nin1_Nout1
@@ -85,6 +145,53 @@ emc_gid_to_point_x: _UFunc_Nin2_Nout1
 emc_gid_to_point_y: _UFunc_Nin2_Nout1
 emc_gid_to_point_z: _UFunc_Nin2_Nout1
 emc_adc_to_charge: _UFunc_Nin2_Nout1
+parse_emc_gid: np.ufunc
+emc_gid_to_geometry: np.ufunc
+
+def _emc_match_crystals(
+    x: np.ndarray, y: np.ndarray, z: np.ndarray, k: int, /
+) -> tuple[np.ndarray, np.ndarray]: ...
+def _emc_neighbours() -> np.ndarray: ...
+def _emc_cluster_hits(
+    offsets: np.ndarray, gid: np.ndarray, energy: np.ndarray, /
+) -> tuple[np.ndarray, np.ndarray, np.ndarray, np.ndarray]: ...
+def _emc_shower_shape(
+    hit_offsets: np.ndarray,
+    gid: np.ndarray,
+    energy: np.ndarray,
+    seed_offsets: np.ndarray,
+    seed: np.ndarray,
+    log_weight: float,
+    /,
+) -> tuple[np.ndarray, ...]: ...
+
+# detectors/muc.cc
+def _init_muc_geom(
+    center_x: np.ndarray,
+    center_y: np.ndarray,
+    center_z: np.ndarray,
+    dir_x: np.ndarray,
+    dir_y: np.ndarray,
+    dir_z: np.ndarray,
+    length: np.ndarray,
+    /,
+): ...
+
+get_muc_gid: np.ufunc
+muc_id_to_gid: _UFunc_Nin1_Nout1
+muc_gid_to_part: _UFunc_Nin1_Nout1
+muc_gid_to_segment: _UFunc_Nin1_Nout1
+muc_gid_to_gap: _UFunc_Nin1_Nout1
+muc_gid_to_strip: _UFunc_Nin1_Nout1
+muc_gid_to_is_barrel: _UFunc_Nin1_Nout1
+parse_muc_gid: np.ufunc
+muc_gid_to_center_x: _UFunc_Nin1_Nout1
+muc_gid_to_center_y: _UFunc_Nin1_Nout1
+muc_gid_to_center_z: _UFunc_Nin1_Nout1
+muc_gid_to_dir_x: _UFunc_Nin1_Nout1
+muc_gid_to_dir_y: _UFunc_Nin1_Nout1
+muc_gid_to_dir_z: _UFunc_Nin1_Nout1
+muc_gid_to_length: _UFunc_Nin1_Nout1
 
 # helix.cc
 dr_phi0_to_x: _UFunc_Nin2_Nout1
@@ -93,7 +200,14 @@ phi0_to_phi: _UFunc_Nin1_Nout1
 kappa_to_pt: _UFunc_Nin1_Nout1
 kappa_to_charge: _UFunc_Nin1_Nout1
 kappa_to_radius: _UFunc_Nin1_Nout1
+helix_kinematics: np.ufunc
+_helix_momentum: np.ufunc
+_helix_position: np.ufunc
+helix_to_cylinder: np.ufunc
+helix_to_z_plane: np.ufunc
 _fix_dr_sign: np.ufunc
+_helix_change_pivot: np.ufunc
+_helix_change_pivot_error: np.ufunc
 
 # identifier.cc
 ## mdc
@@ -101,6 +215,7 @@ check_mdc_id: _UFunc_Nin1_Nout1
 mdc_id_to_wire: _UFunc_Nin1_Nout1
 mdc_id_to_layer: _UFunc_Nin1_Nout1
 mdc_id_to_is_stereo: _UFunc_Nin1_Nout1
+parse_mdc_id: np.ufunc
 get_mdc_id: np.ufunc
 
 ## tof
@@ -111,6 +226,7 @@ _tof_id_to_layer_or_module_1: _UFunc_Nin1_Nout1
 _tof_id_to_layer_or_module_2: _UFunc_Nin2_Nout1
 _tof_id_to_phi_or_strip_1: _UFunc_Nin1_Nout1
 _tof_id_to_phi_or_strip_2: _UFunc_Nin2_Nout1
+parse_tof_id: np.ufunc
 get_tof_id: np.ufunc
 
 ## emc
@@ -118,6 +234,7 @@ check_emc_id: _UFunc_Nin1_Nout1
 emc_id_to_module: _UFunc_Nin1_Nout1
 emc_id_to_theta: _UFunc_Nin1_Nout1
 emc_id_to_phi: _UFunc_Nin1_Nout1
+parse_emc_id: np.ufunc
 get_emc_id: np.ufunc
 
 ## muc
@@ -126,6 +243,7 @@ muc_id_to_part: _UFunc_Nin1_Nout1
 muc_id_to_segment: _UFunc_Nin1_Nout1
 muc_id_to_layer: _UFunc_Nin1_Nout1
 muc_id_to_channel: _UFunc_Nin1_Nout1
+parse_muc_id: np.ufunc
 get_muc_id: np.ufunc
 
 ## cgem
@@ -134,4 +252,33 @@ cgem_id_to_layer: _UFunc_Nin1_Nout1
 cgem_id_to_sheet: _UFunc_Nin1_Nout1
 cgem_id_to_strip_type: _UFunc_Nin1_Nout1
 cgem_id_to_strip: _UFunc_Nin1_Nout1
+parse_cgem_id: np.ufunc
 get_cgem_id: np.ufunc
+
+## mixed detectors
+decode_digi_id: np.ufunc
+
+# reduce.cc
+def _reduce_events(
+    offsets: np.ndarray,
+    values: np.ndarray | None,
+    keys: np.ndarray | None,
+    n_keys: int,
+    op: str,
+    /,
+) -> np.ndarray: ...
+def _fill_channel_hist(
+    occupancy: np.ndarray,
+    hist: np.ndarray | None,
+    gid: np.ndarray,
+    value: np.ndarray | None,
+    lo: float,
+    hi: float,
+    /,
+) -> int: ...
+
+# thread_pool.cc
+def _set_num_threads(n: int, /) -> None: ...
+def _get_num_threads() -> int: ...
+def _set_parallel_threshold(n: int, /) -> None: ...
+def _get_parallel_threshold() -> int: ...
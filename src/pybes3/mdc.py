@@ -6,6 +6,7 @@ import awkward as ak
 import numpy as np
 
 import pybes3.kernels.ufuncs as _ufuncs
+from pybes3._utils import _apply_jagged
 from pybes3.data import MDC_GEOM
 from pybes3.typing import BoolLike, FloatLike, IntLike
 
@@ -293,6 +294,61 @@ def mdc_gid_z_to_y(gid: IntLike, z: FloatLike) -> FloatLike:
     return _ufuncs.mdc_gid_z_to_y(gid, z)
 
 
+def mdc_layer_nearest_wire(
+    layer: IntLike, x: FloatLike, y: FloatLike, z: FloatLike
+) -> tuple[IntLike, FloatLike]:
+    """
+    Get the wire of a layer nearest to a point.
+
+    The distance is measured in the x-y plane at the z of the point, so the twist of
+    stereo wires is taken into account. Wires are looked up with a binary search in a
+    per-layer index sorted by phi.
+
+    Parameters:
+        layer: The layer number.
+        x: The x (cm) position of the point.
+        y: The y (cm) position of the point.
+        z: The z (cm) position of the point.
+
+    Returns:
+        Tuple of the global ID of the nearest wire and its distance (cm) to the point.
+            Invalid layers and non-finite points give gid `-1` and distance `nan`.
+    """
+    return _apply_jagged(_ufuncs.mdc_layer_nearest_wire, layer, x, y, z)
+
+
+def mdc_helix_doca(helix, gid: IntLike) -> tuple[FloatLike, FloatLike]:
+    """
+    Get the distance of closest approach (DOCA) between helices and wires.
+
+    The closest approach is searched within half a turn of the helix before or after its
+    pivot, taking the stereo angle of the wire into account.
+
+    Parameters:
+        helix: The helix, either a `HelixObject` or an awkward array of helices. Awkward
+            arrays are broadcast with `gid`, e.g. one helix per (track, hit) pair.
+        gid: The global ID of the wire.
+
+    Returns:
+        Tuple of the signed DOCA (cm) and the z (cm) of the helix at the closest approach.
+            DOCA is positive if the wire is on the left of the track in the x-y plane,
+            looking along the flight direction.
+    """
+    pivot = helix.pivot
+    return _apply_jagged(
+        _ufuncs.mdc_helix_doca,
+        helix.dr,
+        helix.phi0,
+        helix.kappa,
+        helix.dz,
+        helix.tanl,
+        pivot.x,
+        pivot.y,
+        pivot.z,
+        gid,
+    )
+
+
 def parse_mdc_gid(gid: IntLike, geometry: bool = False) -> ak.Array | dict[str, Any]:
     """
     Parse the gid of MDC wires. "gid" is the global ID of the wire, ranges from 0 to 6795.
@@ -325,31 +381,29 @@ def parse_mdc_gid(gid: IntLike, geometry: bool = False) -> ak.Array | dict[str,
     Returns:
         The parsed result.
     """
-    layer = _ufuncs.mdc_gid_to_layer(gid)
-    wire = _ufuncs.mdc_gid_to_wire(gid)
+    layer, wire, stereo, is_stereo, superlayer = _apply_jagged(_ufuncs.parse_mdc_gid, gid)
 
     res = {
         "gid": gid,
         "layer": layer,
         "wire": wire,
-        "stereo": _ufuncs.mdc_gid_to_stereo(gid),
-        "is_stereo": _ufuncs.mdc_gid_to_is_stereo(gid),
-        "superlayer": _ufuncs.mdc_gid_to_superlayer(gid),
+        "stereo": stereo,
+        "is_stereo": is_stereo,
+        "superlayer": superlayer,
     }
 
     if geometry:
-        west_x = _ufuncs.mdc_gid_to_west_x(gid)
-        west_y = _ufuncs.mdc_gid_to_west_y(gid)
-        east_x = _ufuncs.mdc_gid_to_east_x(gid)
-        east_y = _ufuncs.mdc_gid_to_east_y(gid)
-        res["mid_x"] = (west_x + east_x) / 2
-        res["mid_y"] = (west_y + east_y) / 2
-        res["west_x"] = west_x
-        res["west_y"] = west_y
-        res["west_z"] = _ufuncs.mdc_gid_to_west_z(gid)
-        res["east_x"] = east_x
-        res["east_y"] = east_y
-        res["east_z"] = _ufuncs.mdc_gid_to_east_z(gid)
+        geom_keys = [
+            "mid_x",
+            "mid_y",
+            "west_x",
+            "west_y",
+            "west_z",
+            "east_x",
+            "east_y",
+            "east_z",
+        ]
+        res.update(zip(geom_keys, _apply_jagged(_ufuncs.mdc_gid_to_geometry, gid)))
 
     if isinstance(gid, ak.Array):
         return ak.zip(res)
@@ -0,0 +1,162 @@
+from __future__ import annotations
+
+from typing import TYPE_CHECKING
+
+import numpy as np
+
+import pybes3.kernels.ufuncs as _ufuncs
+from pybes3._utils import _flat_float64, _flat_to_numpy
+from pybes3.typing import FloatLike, IntLike
+
+if TYPE_CHECKING:
+    from typing_extensions import Self
+
+
+class ChannelHistogram:
+    """
+    Per-channel occupancy and value histograms, filled chunk by chunk.
+
+    The hits of each channel (gid) are counted into `occupancy`, and when `bins` is given,
+    their values (e.g. ADC or TDC) are filled into a histogram of each channel. Large
+    chunks are filled with private bins of each thread, merged at the end of the chunk.
+    The GIL is released while filling, so that it can run alongside the data reading.
+
+    Filling the same histogram from several Python threads at the same time is not
+    supported, use one histogram per thread and merge them with `+=` instead.
+
+    Parameters:
+        n_channels: Number of channels, e.g. `pybes3.mdc.N_WIRES`.
+        bins: Number of value bins. Only the occupancy is filled if `None`.
+        range: The lower and upper edges of the value bins. The upper edge is included
+            in the last bin, values out of range are counted in `underflow` and
+            `overflow`.
+    """
+
+    def __init__(
+        self,
+        n_channels: int,
+        bins: int | None = None,
+        range: tuple[float, float] | None = None,
+    ) -> None:
+        if n_channels < 1:
+            raise ValueError("n_channels must be positive")
+
+        if (bins is None) != (range is None):
+            raise ValueError("bins and range must be given together")
+
+        if bins is not None and bins < 1:
+            raise ValueError("bins must be positive")
+
+        if range is not None and not (np.isfinite(range).all() and range[0] < range[1]):
+            raise ValueError("range must be finite and increasing")
+
+        self.n_channels = int(n_channels)
+        self.bins = None if bins is None else int(bins)
+        self.range = None if range is None else (float(range[0]), float(range[1]))
+        self.n_invalid = 0
+
+        self._occupancy = np.zeros(self.n_channels, dtype=np.int64)
+        self._hist = (
+            None
+            if self.bins is None
+            else np.zeros((self.n_channels, self.bins + 2), dtype=np.int64)
+        )
+
+    def fill(self, gid: IntLike, value: FloatLike | None = None) -> None:
+        """
+        Fill hits into the histograms.
+
+        Parameters:
+            gid: The gid of the hits, of any shape. Hits with gid out of
+                `[0, n_channels)` are skipped and counted in `n_invalid`.
+            value: The values of the hits, with the same number of elements as `gid`.
+                Required if and only if `bins` is given. `nan` values are only counted
+                in the occupancy.
+        """
+        if (value is None) != (self._hist is None):
+            raise ValueError("value must be given if and only if bins is given")
+
+        flat_gid = np.ascontiguousarray(_flat_to_numpy(gid), dtype=np.int64).reshape(-1)
+        flat_value = None if value is None else _flat_float64(_flat_to_numpy(value))
+        lo, hi = (0.0, 1.0) if self.range is None else self.range
+
+        self.n_invalid += _ufuncs._fill_channel_hist(
+            self._occupancy, self._hist, flat_gid, flat_value, lo, hi
+        )
+
+    @property
+    def occupancy(self) -> np.ndarray:
+        """
+        Number of hits of each channel, in shape `(n_channels,)`.
+        """
+        return self._occupancy
+
+    @property
+    def hist(self) -> np.ndarray | None:
+        """
+        Value histograms of the channels, in shape `(n_channels, bins)`.
+        """
+        return None if self._hist is None else self._hist[:, 1:-1]
+
+    @property
+    def underflow(self) -> np.ndarray | None:
+        """
+        Number of values below the range of each channel.
+        """
+        return None if self._hist is None else self._hist[:, 0]
+
+    @property
+    def overflow(self) -> np.ndarray | None:
+        """
+        Number of values above the range of each channel.
+        """
+        return None if self._hist is None else self._hist[:, -1]
+
+    @property
+    def edges(self) -> np.ndarray | None:
+        """
+        Edges of the value bins, in shape `(bins + 1,)`.
+        """
+        return None if self.range is None else np.linspace(*self.range, self.bins + 1)
+
+    def reset(self) -> None:
+        """
+        Reset all counts to 0.
+        """
+        self._occupancy[:] = 0
+        if self._hist is not None:
+            self._hist[:] = 0
+        self.n_invalid = 0
+
+    def __iadd__(self, other: ChannelHistogram) -> Self:
+        if not isinstance(other, ChannelHistogram):
+            return NotImplemented
+
+        if (self.n_channels, self.bins, self.range) != (
+            other.n_channels,
+            other.bins,
+            other.range,
+        ):
+            raise ValueError("Cannot merge histograms with different channels or bins")
+
+        self._occupancy += other._occupancy
+        if self._hist is not None:
+            self._hist += other._hist
+        self.n_invalid += other.n_invalid
+        return self
+
+    def to_numpy(self) -> dict[str, np.ndarray]:
+        """
+        Copy the histograms to numpy arrays.
+
+        Returns:
+            A dictionary with `occupancy`, and when `bins` is given, `hist`, `underflow`,
+                `overflow` and `edges`.
+        """
+        res = {"occupancy": self.occupancy.copy()}
+        if self._hist is not None:
+            res["hist"] = self.hist.copy()
+            res["underflow"] = self.underflow.copy()
+            res["overflow"] = self.overflow.copy()
+            res["edges"] = self.edges
+        return res
@@ -0,0 +1,255 @@
+from __future__ import annotations
+
+from typing import Any
+
+import awkward as ak
+import numpy as np
+
+import pybes3.kernels.ufuncs as _ufuncs
+from pybes3._utils import _apply_jagged
+from pybes3.typing import BoolLike, FloatLike, IntLike
+
+N_PARTS = 3
+N_SEGMENTS = np.array([4, 8, 4])
+N_GAPS = np.array([8, 9, 8])
+N_STRIPS = 9152
+
+ENDCAP_STRIPS = 64
+BARREL_Z_STRIPS = 48
+BARREL_PHI_STRIPS = 96
+BARREL_TOP_PHI_STRIPS = 112
+BARREL_TOP_SEGMENT = 2
+
+N_SEGMENTS.setflags(write=False)
+N_GAPS.setflags(write=False)
+
+
+def init_muc_geom(
+    center_x: np.ndarray,
+    center_y: np.ndarray,
+    center_z: np.ndarray,
+    dir_x: np.ndarray,
+    dir_y: np.ndarray,
+    dir_z: np.ndarray,
+    length: np.ndarray,
+) -> None:
+    """
+    Initialize the MUC strip geometry used by the `muc_gid_to_*` geometry functions.
+
+    The MUC geometry is not shipped with `pybes3`. Until this function is called, all
+    geometry functions return `nan`. Each array should have one entry per strip, in gid
+    order (e.g. exported from `MucGeomSvc` in `BOSS`).
+
+    Parameters:
+        center_x: The x coordinate of the strip centers.
+        center_y: The y coordinate of the strip centers.
+        center_z: The z coordinate of the strip centers.
+        dir_x: The x component of the unit vectors along the strips.
+        dir_y: The y component of the unit vectors along the strips.
+        dir_z: The z component of the unit vectors along the strips.
+        length: The length of the strips.
+    """
+    _ufuncs._init_muc_geom(
+        *(
+            np.ascontiguousarray(v, dtype=np.float64)
+            for v in (center_x, center_y, center_z, dir_x, dir_y, dir_z, length)
+        )
+    )
+
+
+def get_muc_gid(part: IntLike, segment: IntLike, gap: IntLike, strip: IntLike) -> IntLike:
+    """
+    Get MUC gid of given part, segment, gap and strip.
+
+    Parameters:
+        part: The part number, 0 for east endcap, 1 for barrel, 2 for west endcap.
+        segment: The segment number within the part.
+        gap: The gap (layer) number within the segment.
+        strip: The strip number within the gap.
+
+    Returns:
+        The global ID of the MUC strip, ranging from 0 to 9151.
+    """
+    return _ufuncs.get_muc_gid(part, segment, gap, strip)
+
+
+def muc_gid_to_part(gid: IntLike) -> IntLike:
+    """
+    Convert MUC gid to part number.
+
+    Parameters:
+        gid: The global ID of the MUC strip.
+
+    Returns:
+        The part number, 0 for east endcap, 1 for barrel, 2 for west endcap.
+    """
+    return _ufuncs.muc_gid_to_part(gid)
+
+
+def muc_gid_to_segment(gid: IntLike) -> IntLike:
+    """
+    Convert MUC gid to segment number.
+
+    Parameters:
+        gid: The global ID of the MUC strip.
+
+    Returns:
+        The segment number within the part.
+    """
+    return _ufuncs.muc_gid_to_segment(gid)
+
+
+def muc_gid_to_gap(gid: IntLike) -> IntLike:
+    """
+    Convert MUC gid to gap (layer) number.
+
+    Parameters:
+        gid: The global ID of the MUC strip.
+
+    Returns:
+        The gap number within the segment.
+    """
+    return _ufuncs.muc_gid_to_gap(gid)
+
+
+def muc_gid_to_strip(gid: IntLike) -> IntLike:
+    """
+    Convert MUC gid to strip number.
+
+    Parameters:
+        gid: The global ID of the MUC strip.
+
+    Returns:
+        The strip number within the gap.
+    """
+    return _ufuncs.muc_gid_to_strip(gid)
+
+
+def muc_gid_to_is_barrel(gid: IntLike) -> BoolLike:
+    """
+    Check whether a MUC gid corresponds to a barrel strip.
+
+    Parameters:
+        gid: The global ID of the MUC strip.
+
+    Returns:
+        True if the strip is in the barrel, otherwise False.
+    """
+    return _ufuncs.muc_gid_to_is_barrel(gid)
+
+
+def parse_muc_gid(gid: IntLike) -> ak.Array | dict[str, Any]:
+    """
+    Parse MUC gid into part, segment, gap and strip number.
+
+    Parameters:
+        gid: The global ID of the MUC strip.
+
+    Returns:
+        If gid is a ak.Array, returns an ak.Array with fields "part", "segment", "gap"
+        and "strip". Otherwise, returns a dictionary with the same keys.
+    """
+    part, segment, gap, strip = _apply_jagged(_ufuncs.parse_muc_gid, gid)
+
+    res = {
+        "part": part,
+        "segment": segment,
+        "gap": gap,
+        "strip": strip,
+    }
+
+    if isinstance(gid, ak.Array):
+        return ak.zip(res)
+    else:
+        return res
+
+
+def muc_gid_to_center_x(gid: IntLike) -> FloatLike:
+    """
+    Convert MUC gid to x coordinate of the strip center. Requires `init_muc_geom`.
+
+    Parameters:
+        gid: The global ID of the MUC strip.
+
+    Returns:
+        The x coordinate of the strip center.
+    """
+    return _ufuncs.muc_gid_to_center_x(gid)
+
+
+def muc_gid_to_center_y(gid: IntLike) -> FloatLike:
+    """
+    Convert MUC gid to y coordinate of the strip center. Requires `init_muc_geom`.
+
+    Parameters:
+        gid: The global ID of the MUC strip.
+
+    Returns:
+        The y coordinate of the strip center.
+    """
+    return _ufuncs.muc_gid_to_center_y(gid)
+
+
+def muc_gid_to_center_z(gid: IntLike) -> FloatLike:
+    """
+    Convert MUC gid to z coordinate of the strip center. Requires `init_muc_geom`.
+
+    Parameters:
+        gid: The global ID of the MUC strip.
+
+    Returns:
+        The z coordinate of the strip center.
+    """
+    return _ufuncs.muc_gid_to_center_z(gid)
+
+
+def muc_gid_to_dir_x(gid: IntLike) -> FloatLike:
+    """
+    Convert MUC gid to x component of the strip direction. Requires `init_muc_geom`.
+
+    Parameters:
+        gid: The global ID of the MUC strip.
+
+    Returns:
+        The x component of the unit vector along the strip.
+    """
+    return _ufuncs.muc_gid_to_dir_x(gid)
+
+
+def muc_gid_to_dir_y(gid: IntLike) -> FloatLike:
+    """
+    Convert MUC gid to y component of the strip direction. Requires `init_muc_geom`.
+
+    Parameters:
+        gid: The global ID of the MUC strip.
+
+    Returns:
+        The y component of the unit vector along the strip.
+    """
+    return _ufuncs.muc_gid_to_dir_y(gid)
+
+
+def muc_gid_to_dir_z(gid: IntLike) -> FloatLike:
+    """
+    Convert MUC gid to z component of the strip direction. Requires `init_muc_geom`.
+
+    Parameters:
+        gid: The global ID of the MUC strip.
+
+    Returns:
+        The z component of the unit vector along the strip.
+    """
+    return _ufuncs.muc_gid_to_dir_z(gid)
+
+
+def muc_gid_to_length(gid: IntLike) -> FloatLike:
+    """
+    Convert MUC gid to the strip length. Requires `init_muc_geom`.
+
+    Parameters:
+        gid: The global ID of the MUC strip.
+
+    Returns:
+        The length of the strip.
+    """
+    return _ufuncs.muc_gid_to_length(gid)
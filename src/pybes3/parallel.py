@@ -0,0 +1,46 @@
+from __future__ import annotations
+
+import pybes3.kernels.ufuncs as _ufuncs
+
+
+def set_num_threads(n: int | None = None, threshold: int | None = None) -> None:
+    """
+    Set the number of threads used by the ufuncs in `pybes3`.
+
+    Ufunc loops on contiguous arrays with at least `threshold` elements are split across
+    a persistent native thread pool. Multi-threading is opt-in: only 1 thread is used
+    until this function is called, and calling it without arguments uses all available
+    cores. Inputs should already have the dtype of a ufunc loop (e.g. `int64` gid,
+    `float64` positions), since NumPy processes arrays that need casting in small
+    buffered chunks.
+
+    Parameters:
+        n: Number of threads, including the calling thread. `None` (default) or `0` uses
+            all available cores, `1` disables multi-threading.
+        threshold: Minimal number of elements of a loop to be split across threads.
+            Unchanged if `None`.
+    """
+    if threshold is not None:
+        _ufuncs._set_parallel_threshold(threshold)
+
+    _ufuncs._set_num_threads(0 if n is None else n)
+
+
+def get_num_threads() -> int:
+    """
+    Get the number of threads used by the ufuncs in `pybes3`.
+
+    Returns:
+        The number of threads.
+    """
+    return _ufuncs._get_num_threads()
+
+
+def get_parallel_threshold() -> int:
+    """
+    Get the minimal number of elements of a ufunc loop to be split across threads.
+
+    Returns:
+        The threshold.
+    """
+    return _ufuncs._get_parallel_threshold()
@@ -6,7 +6,14 @@ import awkward as ak
 import numpy as np
 
 import pybes3.kernels.ufuncs as _ufuncs
-from pybes3.typing import BoolLike, IntLike
+from pybes3._utils import (
+    _apply_jagged,
+    _flat_events,
+    _flat_float64,
+    _rewrap_lists,
+    _unwrap_lists,
+)
+from pybes3.typing import BoolLike, FloatLike, IntLike
 
 N_PARTS = 5
 N_LAYER_OR_MODULE = np.array([1, 2, 1, 36, 36])
@@ -82,9 +89,7 @@ def parse_tof_gid(gid: IntLike) -> ak.Array | dict[str, Any]:
         If gid is a ak.Array, returns an ak.Array with fields "part", "layer_or_module" and "phi_or_strip".
         Otherwise, returns a dictionary with keys "part", "layer_or_module" and "phi_or_strip".
     """
-    part = _ufuncs.tof_gid_to_part(gid)
-    layer_or_module = _ufuncs.tof_gid_to_layer_or_module(gid)
-    phi_or_strip = _ufuncs.tof_gid_to_phi_or_strip(gid)
+    part, layer_or_module, phi_or_strip = _apply_jagged(_ufuncs.parse_tof_gid, gid)
 
     res = {
         "part": part,
@@ -194,3 +199,291 @@ def parse_tof_hit_status(status: IntLike) -> ak.Array | dict[str, Any]:
         return ak.zip(res)
     else:
         return res
+
+
+def pair_tof_ends(
+    tof_id: ak.Array,
+    tdc: ak.Array,
+    adc: ak.Array,
+    overflow: ak.Array,
+    v_eff: FloatLike,
+    time_walk: FloatLike = 0.0,
+    tdc_to_ns: FloatLike = 1.0,
+) -> ak.Array:
+    """
+    Pair the east and west readouts of the TOF counters hit in each event.
+
+    Digis of the same counter (same gid) are grouped, and the earliest digi of each end is
+    used. The time of each end is `tdc * tdc_to_ns - time_walk / sqrt(adc)`, the time of
+    the counter is the mean of both ends, and the hit position along the counter is
+    `z = v_eff * (t_west - t_east) / 2`, which is positive towards the east end.
+
+    The constants are given per part (arrays of length 5) or as scalars for all parts,
+    take them from the TOF calibration of the run being analysed.
+
+    Fields of the output:
+
+    - `gid`: gid of the counter.
+    - `time`: Time of the counter. Counters with only one fired end use its time.
+    - `z`: Hit position along the counter, `nan` when only one end fired.
+    - `time_east`, `time_west`: Time of each end, `nan` when the end did not fire.
+    - `adc_east`, `adc_west`: ADC of each end, `nan` when the end did not fire.
+    - `is_overflow`: Whether the digi of either end overflowed.
+
+    Parameters:
+        tof_id: The TOF digi ID, in shape `(n_events, var)`.
+        tdc: The TDC of the digis, in the same shape as `tof_id`.
+        adc: The ADC of the digis, in the same shape as `tof_id`.
+        overflow: The overflow flag of the digis, in the same shape as `tof_id`.
+        v_eff: Effective light velocity in the counter of each part.
+        time_walk: Time-walk constant of each part, in ns times sqrt of ADC.
+        tdc_to_ns: Conversion from TDC to ns of each part.
+
+    Returns:
+        The counter hits in shape `(n_events, n_counters)`, sorted by gid.
+    """
+    tof_id, tdc, adc, overflow = ak.broadcast_arrays(tof_id, tdc, adc, overflow)
+    if tof_id.ndim != 2:
+        raise ValueError("tof_id, tdc, adc and overflow must be in shape (n_events, var)")
+
+    params = np.array(
+        [np.broadcast_to(v, N_PARTS) for v in (tdc_to_ns, time_walk, v_eff)], dtype=np.float64
+    )
+
+    _, offsets, flat_id = _flat_events(tof_id, np.int64)
+    flat_tdc = _flat_events(tdc, np.float64)[2]
+    flat_adc = _flat_events(adc, np.float64)[2]
+    flat_overflow = _flat_events(overflow, np.bool_)[2]
+
+    flat_gid = _ufuncs.tof_id_to_gid(flat_id)
+    flat_end = _ufuncs.tof_id_to_end(flat_id).astype(np.int64)
+
+    hit_offsets, *values = _ufuncs._tof_pair_ends(
+        offsets, flat_gid, flat_end, flat_tdc, flat_adc, flat_overflow, params
+    )
+
+    n_hits = np.diff(hit_offsets)
+    fields = ["gid", "time", "z", "time_east", "time_west", "adc_east", "adc_west"]
+    fields.append("is_overflow")
+    return ak.zip({k: ak.unflatten(v, n_hits) for k, v in zip(fields, values)})
+
+
+def init_tof_geom(
+    center_x: np.ndarray,
+    center_y: np.ndarray,
+    center_z: np.ndarray,
+    phi_min: np.ndarray,
+    phi_max: np.ndarray,
+    z_min: np.ndarray,
+    z_max: np.ndarray,
+    r_min: np.ndarray,
+    r_max: np.ndarray,
+) -> None:
+    """
+    Initialize the TOF counter geometry used by the `tof_gid_to_*` geometry functions and
+    `predict_tof_counters`.
+
+    The TOF geometry is not shipped with `pybes3`. Until this function is called, all
+    geometry functions return `nan` and no counter is predicted. Each array should have
+    one entry per counter (scintillator or MRPC strip), in gid order. The extent of a
+    counter is `[phi_min, phi_max]` in phi, which wraps around `2 * pi` when
+    `phi_min > phi_max`, `[z_min, z_max]` in z and `[r_min, r_max]` in the transverse
+    radius.
+
+    Parameters:
+        center_x: The x coordinate of the counter centers.
+        center_y: The y coordinate of the counter centers.
+        center_z: The z coordinate of the counter centers.
+        phi_min: The lower phi edge of the counters.
+        phi_max: The upper phi edge of the counters.
+        z_min: The lower z edge of the counters.
+        z_max: The upper z edge of the counters.
+        r_min: The inner radius of the counters.
+        r_max: The outer radius of the counters.
+    """
+    _ufuncs._init_tof_geom(
+        *(
+            _flat_float64(v)
+            for v in (
+                center_x,
+                center_y,
+                center_z,
+                phi_min,
+                phi_max,
+                z_min,
+                z_max,
+                r_min,
+                r_max,
+            )
+        )
+    )
+
+
+def tof_gid_to_center_x(gid: IntLike) -> FloatLike:
+    """
+    Convert TOF gid to x coordinate of the counter center. Requires `init_tof_geom`.
+
+    Parameters:
+        gid: The global ID of the counter.
+
+    Returns:
+        The x coordinate of the counter center.
+    """
+    return _ufuncs.tof_gid_to_center_x(gid)
+
+
+def tof_gid_to_center_y(gid: IntLike) -> FloatLike:
+    """
+    Convert TOF gid to y coordinate of the counter center. Requires `init_tof_geom`.
+
+    Parameters:
+        gid: The global ID of the counter.
+
+    Returns:
+        The y coordinate of the counter center.
+    """
+    return _ufuncs.tof_gid_to_center_y(gid)
+
+
+def tof_gid_to_center_z(gid: IntLike) -> FloatLike:
+    """
+    Convert TOF gid to z coordinate of the counter center. Requires `init_tof_geom`.
+
+    Parameters:
+        gid: The global ID of the counter.
+
+    Returns:
+        The z coordinate of the counter center.
+    """
+    return _ufuncs.tof_gid_to_center_z(gid)
+
+
+def tof_gid_to_phi_min(gid: IntLike) -> FloatLike:
+    """
+    Convert TOF gid to the lower phi edge of the counter. Requires `init_tof_geom`.
+
+    Parameters:
+        gid: The global ID of the counter.
+
+    Returns:
+        The lower phi edge of the counter.
+    """
+    return _ufuncs.tof_gid_to_phi_min(gid)
+
+
+def tof_gid_to_phi_max(gid: IntLike) -> FloatLike:
+    """
+    Convert TOF gid to the upper phi edge of the counter. Requires `init_tof_geom`.
+
+    Parameters:
+        gid: The global ID of the counter.
+
+    Returns:
+        The upper phi edge of the counter.
+    """
+    return _ufuncs.tof_gid_to_phi_max(gid)
+
+
+def tof_gid_to_z_min(gid: IntLike) -> FloatLike:
+    """
+    Convert TOF gid to the lower z edge of the counter. Requires `init_tof_geom`.
+
+    Parameters:
+        gid: The global ID of the counter.
+
+    Returns:
+        The lower z edge of the counter.
+    """
+    return _ufuncs.tof_gid_to_z_min(gid)
+
+
+def tof_gid_to_z_max(gid: IntLike) -> FloatLike:
+    """
+    Convert TOF gid to the upper z edge of the counter. Requires `init_tof_geom`.
+
+    Parameters:
+        gid: The global ID of the counter.
+
+    Returns:
+        The upper z edge of the counter.
+    """
+    return _ufuncs.tof_gid_to_z_max(gid)
+
+
+def tof_gid_to_r_min(gid: IntLike) -> FloatLike:
+    """
+    Convert TOF gid to the inner radius of the counter. Requires `init_tof_geom`.
+
+    Parameters:
+        gid: The global ID of the counter.
+
+    Returns:
+        The inner radius of the counter.
+    """
+    return _ufuncs.tof_gid_to_r_min(gid)
+
+
+def tof_gid_to_r_max(gid: IntLike) -> FloatLike:
+    """
+    Convert TOF gid to the outer radius of the counter. Requires `init_tof_geom`.
+
+    Parameters:
+        gid: The global ID of the counter.
+
+    Returns:
+        The outer radius of the counter.
+    """
+    return _ufuncs.tof_gid_to_r_max(gid)
+
+
+def predict_tof_counters(
+    x: FloatLike,
+    y: FloatLike,
+    z: FloatLike,
+    k: int = 2,
+    phi_tolerance: float = 0.0,
+    z_tolerance: float = 0.0,
+    r_tolerance: float = 0.0,
+) -> IntLike:
+    """
+    Predict the TOF counters hit by tracks, given the track positions extrapolated to the
+    TOF, e.g. to the radius of each barrel layer or the z of each endcap. Requires
+    `init_tof_geom`.
+
+    A counter is predicted when the point is inside its extent enlarged by the
+    tolerances. A phi grid over the counters is used, so only counters around the point
+    are checked.
+
+    Parameters:
+        x: x coordinate of the points in cm.
+        y: y coordinate of the points in cm.
+        z: z coordinate of the points in cm.
+        k: Maximal number of counters to return for each point.
+        phi_tolerance: Tolerance in phi, in radians.
+        z_tolerance: Tolerance in z, in cm.
+        r_tolerance: Tolerance in the transverse radius, in cm.
+
+    Returns:
+        The gids of the predicted counters, as an additional trailing dimension of length
+            `k`, sorted by the distance between the point and the counter centers and
+            padded with `-1`.
+    """
+    tolerances = (phi_tolerance, z_tolerance, r_tolerance)
+
+    if isinstance(x, ak.Array) or isinstance(y, ak.Array) or isinstance(z, ak.Array):
+        x, y, z = (ak.to_packed(a) for a in ak.broadcast_arrays(x, y, z))
+        unwrapped = _unwrap_lists(x.layout)
+        if unwrapped is None:
+            raise TypeError("x, y and z must be (nested) lists of numbers")
+
+        lists, _ = unwrapped
+        gid = _ufuncs._tof_predict_counters(
+            *(_flat_float64(ak.flatten(a, axis=None).to_numpy()) for a in (x, y, z)),
+            k,
+            *tolerances,
+        )
+        return ak.Array(_rewrap_lists(lists, gid))
+
+    x, y, z = np.broadcast_arrays(x, y, z)
+    gid = _ufuncs._tof_predict_counters(*(_flat_float64(a) for a in (x, y, z)), k, *tolerances)
+    return gid.reshape(*x.shape, k)
@@ -64,3 +64,71 @@ def test_cgem_parse_gid(cgem_gid_dict):
     assert ak.all(ak_res["strip"] == ref_strip)
     assert ak.all(ak_res["is_xstrip"] == (ref_strip_type == cgem.X_STRIP_TYPE))
     assert ak.all(ak_res["is_vstrip"] == (ref_strip_type == cgem.V_STRIP_TYPE))
+
+
+def test_cluster_cgem_strips():
+    x0 = p3.get_cgem_gid(1, 1, 0, 100)
+    v0 = p3.get_cgem_gid(1, 1, 1, 200)
+    last_x = p3.get_cgem_gid(0, 0, 0, cgem.N_XSTRIPS[0] - 1)
+    first_v = p3.get_cgem_gid(0, 0, 1, 0)
+
+    gid = ak.Array([[x0 + 1, v0, x0, x0 + 3, last_x, first_v, -1], []])
+    charge = ak.Array([[3.0, 1.0, 1.0, 2.0, 1.0, 1.0, 1.0], []])
+
+    cluster_id, clusters = p3.cluster_cgem_strips(gid, charge)
+    assert cluster_id.tolist() == [[2, 4, 2, 3, 0, 1, -1], []]
+    assert clusters.gid.tolist() == [[last_x, first_v, x0, x0 + 3, v0], []]
+    assert clusters["size"].tolist() == [[1, 1, 2, 1, 1], []]
+    assert np.allclose(clusters.strip[0, 2], 100.75)
+    assert np.allclose(clusters.charge[0, 2], 4.0)
+
+    cluster_id, clusters = p3.cluster_cgem_strips(gid, charge, max_gap=1)
+    assert clusters["size"].tolist() == [[1, 1, 3, 1], []]
+
+    # X strips wrap around phi = 0 in layer 0 and cross the sheet boundaries in layer 1
+    first_x = p3.get_cgem_gid(0, 0, 0, 0)
+    seam_x = p3.get_cgem_gid(1, 0, 0, cgem.N_XSTRIPS[1] - 1)
+    next_x = p3.get_cgem_gid(1, 1, 0, 0)
+    gid = ak.Array([[first_x + 1, last_x, first_x, next_x, seam_x]])
+    charge = ak.Array([[2.0, 1.0, 1.0, 1.0, 1.0]])
+
+    cluster_id, clusters = p3.cluster_cgem_strips(gid, charge)
+    assert cluster_id.tolist() == [[0, 0, 0, 1, 1]]
+    assert clusters.gid.tolist() == [[last_x, seam_x]]
+    assert clusters["size"].tolist() == [[3, 2]]
+    assert np.allclose(clusters.strip[0, 0], cgem.N_XSTRIPS[0] + 0.25)
+    assert np.allclose(clusters.strip[0, 1], cgem.N_XSTRIPS[1] - 0.5)
+
+
+def test_cgem_xv_intersection():
+    radius, stereo_angle, v_pitch, v_offset = 12.0, -0.9, 0.07, 5.0
+    n_x = cgem.N_SHEETS[1] * cgem.N_XSTRIPS[1]
+    x_strip, z = 100.0, 10.0
+
+    # the V strip passing through (x_strip, z)
+    s = radius * (x_strip + 0.5) * 2 * np.pi / n_x
+    v_strip = (s - v_offset - z * np.tan(stereo_angle)) / v_pitch - 0.5
+
+    clusters = ak.Array(
+        [
+            [
+                {"gid": p3.get_cgem_gid(1, 1, 0, 100), "strip": x_strip},
+                {"gid": p3.get_cgem_gid(1, 1, 1, round(v_strip)), "strip": v_strip},
+                {"gid": p3.get_cgem_gid(1, 0, 1, 0), "strip": 0.0},
+            ],
+            [],
+        ]
+    )
+    points = p3.cgem_xv_intersection(clusters, radius, stereo_angle, v_pitch, v_offset, 40.0)
+    assert ak.num(points).tolist() == [1, 0]
+
+    phi = (cgem.N_XSTRIPS[1] + x_strip + 0.5) * 2 * np.pi / n_x
+    assert np.allclose(points.x[0, 0], radius * np.cos(phi))
+    assert np.allclose(points.y[0, 0], radius * np.sin(phi))
+    assert np.allclose(points.z[0, 0], z)
+    assert points[["layer", "sheet", "x_cluster", "v_cluster"]][0, 0].tolist() == {
+        "layer": 1,
+        "sheet": 1,
+        "x_cluster": 0,
+        "v_cluster": 1,
+    }
@@ -61,3 +61,97 @@ def test_emc_adc_to_charge():
 
     charge = p3.emc_adc_to_charge(measure, adc)
     assert np.allclose(charge, expected_charge, atol=1e-6)
+
+
+def test_match_emc_crystals():
+    gid = p3.get_emc_geom_table()["gid"]
+    x, y, z = emc._front_center_x, emc._front_center_y, emc._front_center_z
+
+    # front centers match their own crystal
+    res_gid, near_gid, near_dist = p3.match_emc_crystals(x, y, z, k=4)
+    assert np.all(res_gid == gid)
+    assert near_gid.shape == (len(gid), 4)
+    assert np.all(np.diff(near_dist, axis=1) >= 0)
+
+    # compare with brute force
+    rng = np.random.default_rng(42)
+    pos = np.stack([x, y, z], axis=1)[rng.integers(0, len(gid), 200)]
+    pos += rng.normal(0, 3, pos.shape)
+    _, near_gid, near_dist = p3.match_emc_crystals(pos[:, 0], pos[:, 1], pos[:, 2], k=4)
+
+    all_dist = np.linalg.norm(pos[:, None, :] - np.stack([x, y, z], axis=1)[None], axis=2)
+    assert np.allclose(near_dist, np.sort(all_dist, axis=1)[:, :4])
+    assert np.allclose(np.take_along_axis(all_dist, near_gid, axis=1), near_dist)
+
+    # jagged input, invalid points
+    ak_x = ak.Array([[x[0], 0.0], [], [x[10]]])
+    ak_y = ak.Array([[y[0], 0.0], [], [y[10]]])
+    ak_z = ak.Array([[z[0], 0.0], [], [z[10]]])
+    res_gid, near_gid, near_dist = p3.match_emc_crystals(ak_x, ak_y, ak_z, k=2)
+    assert res_gid.tolist() == [[0, -1], [], [10]]
+    assert ak.num(near_gid, axis=2).tolist() == [[2, 2], [], [2]]
+    assert np.isnan(near_dist[0, 1, 0])
+
+
+def test_emc_neighbours():
+    nb = p3.emc_gid_to_neighbours(np.arange(emc.N_CRYSTALS))
+    assert nb.shape == (emc.N_CRYSTALS, 8)
+
+    # symmetric
+    gid, k = np.nonzero(nb >= 0)
+    pairs = set(zip(gid.tolist(), nb[gid, k].tolist()))
+    assert all((b, a) in pairs for a, b in pairs)
+
+    # barrel phi wrap and barrel/endcap seams
+    first_barrel = p3.get_emc_gid(1, 0, 0)
+    assert p3.get_emc_gid(1, 0, 119) in nb[first_barrel]
+    assert p3.get_emc_gid(0, 5, 0) in nb[first_barrel]
+    assert p3.get_emc_gid(2, 5, 95) in nb[p3.get_emc_gid(1, 43, 119)]
+    assert np.all(nb[p3.get_emc_gid(0, 0, 10)] != p3.get_emc_gid(2, 0, 10))
+
+    res = p3.emc_gid_to_neighbours(ak.Array([[first_barrel], []]))
+    assert res.tolist() == [[nb[first_barrel].tolist()], []]
+
+    # gids out of range give rows of -1, instead of wrapping around the table
+    bad = p3.emc_gid_to_neighbours(np.array([-1, emc.N_CRYSTALS, first_barrel]))
+    assert np.all(bad[:2] == -1)
+    assert np.all(bad[2] == nb[first_barrel])
+    assert np.all(p3.emc_gid_to_neighbours(-1) == -1)
+
+
+def test_cluster_emc_hits():
+    g = [p3.get_emc_gid(1, 10, phi) for phi in (0, 1, 119, 60)]
+    gid = ak.Array([[g[0], g[3], g[1], g[2], -1], [], [g[3]]])
+    energy = ak.Array([[0.1, 0.5, 0.3, 0.2, 1.0], [], [0.7]])
+
+    cluster_id, seed, cluster_energy = p3.cluster_emc_hits(gid, energy)
+    assert cluster_id.tolist() == [[0, 1, 0, 0, -1], [], [0]]
+    assert seed.tolist() == [[g[1], g[3]], [], [g[3]]]
+    assert np.allclose(ak.flatten(cluster_energy), [0.6, 0.5, 0.7])
+
+
+def test_emc_shower_shape():
+    seed = p3.get_emc_gid(1, 20, 30)
+    nb = p3.emc_gid_to_neighbours(seed)
+    nb2 = np.unique(p3.emc_gid_to_neighbours(nb[nb >= 0]))
+    outer = np.setdiff1d(nb2, np.append(nb, seed))
+    assert len(outer) == 16
+
+    gid = ak.Array([[seed, nb[0], outer[0], p3.get_emc_gid(1, 40, 90)], [seed]])
+    energy = ak.Array([[1.0, 0.2, 0.1, 0.5], [0.3]])
+    res = p3.emc_shower_shape(gid, energy, ak.Array([[seed, -1], [seed]]))
+
+    assert ak.num(res).tolist() == [2, 1]
+    assert np.allclose(res.e1[0, 0], 1.0)
+    assert np.allclose(res.e3x3[0, 0], 1.2)
+    assert np.allclose(res.e5x5[0, 0], 1.3)
+    assert np.allclose(res.e1_e9[0, 0], 1.0 / 1.2)
+    assert np.isnan(res.e1[0, 1])
+
+    # a single crystal
+    assert np.allclose(res.e1_e9[1, 0], 1.0)
+    assert np.allclose(res.lat_moment[1, 0], 0.0)
+    assert np.allclose(
+        [res.x[1, 0], res.y[1, 0], res.z[1, 0]],
+        [emc._front_center_x[seed], emc._front_center_y[seed], emc._front_center_z[seed]],
+    )
@@ -92,3 +92,102 @@ def test_mdc_parse_gid():
         "is_stereo",
         "superlayer",
     ]
+
+    geom_table = p3.get_mdc_geom_table()
+    for field in mdc_fields:
+        if field in geom_table:
+            assert np.all(np_res1[field] == geom_table[field])
+    assert np.all(np_res1["mid_x"] == (geom_table["west_x"] + geom_table["east_x"]) / 2)
+    assert np.all(np_res1["mid_y"] == (geom_table["west_y"] + geom_table["east_y"]) / 2)
+
+    # jagged input goes through the multi-output ufuncs in one broadcast
+    jagged_gid = ak.unflatten(ak_gid, [1000, 0, 5796])
+    jagged_res = p3.parse_mdc_gid(jagged_gid, geometry=True)
+    assert ak.array_equal(ak.flatten(jagged_res), ak_res1)
+
+
+def test_mdc_multithread():
+    gid = np.tile(p3.get_mdc_geom_table()["gid"].astype(np.int64), 20)
+    z = np.linspace(-100, 100, len(gid))
+
+    ref_x = p3.mdc_gid_z_to_x(gid, z)
+    ref_parsed = p3.parse_mdc_gid(gid, geometry=True)
+
+    n_threads, threshold = p3.get_num_threads(), p3.get_parallel_threshold()
+    try:
+        p3.set_num_threads(4, threshold=1000)
+        assert p3.get_num_threads() == 4
+
+        assert np.all(p3.mdc_gid_z_to_x(gid, z) == ref_x)
+        parsed = p3.parse_mdc_gid(gid, geometry=True)
+        for k, v in ref_parsed.items():
+            assert np.all(parsed[k] == v)
+    finally:
+        p3.set_num_threads(n_threads, threshold=threshold)
+
+
+def test_mdc_helix_doca():
+    geom_table = p3.get_mdc_geom_table()
+    gid = geom_table["gid"][~p3.mdc_gid_to_is_stereo(geom_table["gid"])][100]
+    mid_x = (p3.mdc_gid_to_west_x(gid) + p3.mdc_gid_to_east_x(gid)) / 2
+    mid_y = (p3.mdc_gid_to_west_y(gid) + p3.mdc_gid_to_east_y(gid)) / 2
+
+    # stiff track pointing to an axial wire, shifted to its right by dr
+    phi0 = np.arctan2(-mid_x, mid_y) % (2 * np.pi)
+    for dr in (0.5, -0.5):
+        helix = p3.helix_obj(dr, phi0, 0.001, 1.0, 0.0)
+        doca, z = p3.mdc_helix_doca(helix, gid)
+        assert np.isclose(doca, dr, atol=1e-3)
+        assert np.isclose(z, 1.0)
+
+    # one helix per (track, hit) pair
+    helix = p3.helix_awk(
+        dr=ak.Array([[0.5, -0.5], []]),
+        phi0=ak.Array([[phi0, phi0], []]),
+        kappa=ak.Array([[0.001, 0.001], []]),
+        dz=ak.Array([[1.0, 1.0], []]),
+        tanl=ak.Array([[0.0, 0.0], []]),
+    )
+    doca, z = p3.mdc_helix_doca(helix, ak.Array([[gid, gid], []]))
+    assert ak.all(np.isclose(doca, helix.dr, atol=1e-3))
+    assert ak.num(z).tolist() == [2, 0]
+
+
+def test_mdc_layer_nearest_wire():
+    gid = p3.get_mdc_geom_table()["gid"]
+    layer = p3.mdc_gid_to_layer(gid)
+
+    # points on the wires
+    for z in (-20.0, 0.0, 20.0):
+        x = p3.mdc_gid_z_to_x(gid, z)
+        y = p3.mdc_gid_z_to_y(gid, z)
+        res_gid, res_dist = p3.mdc_layer_nearest_wire(layer, x, y, z)
+        assert np.all(res_gid == gid)
+        assert np.allclose(res_dist, 0, atol=1e-6)
+
+    # compare with brute force
+    rng = np.random.default_rng(42)
+    sel = rng.choice(gid, 200)
+    z = rng.uniform(-30, 30, len(sel))
+    x = p3.mdc_gid_z_to_x(sel, z) + rng.normal(0, 2, len(sel))
+    y = p3.mdc_gid_z_to_y(sel, z) + rng.normal(0, 2, len(sel))
+    res_gid, res_dist = p3.mdc_layer_nearest_wire(p3.mdc_gid_to_layer(sel), x, y, z)
+
+    for i in range(len(sel)):
+        layer_gid = gid[layer == p3.mdc_gid_to_layer(sel[i])]
+        dist = np.hypot(
+            x[i] - p3.mdc_gid_z_to_x(layer_gid, z[i]),
+            y[i] - p3.mdc_gid_z_to_y(layer_gid, z[i]),
+        )
+        assert res_gid[i] == layer_gid[np.argmin(dist)]
+        assert np.isclose(res_dist[i], dist.min())
+
+    # non-finite points and invalid layers
+    res_gid, res_dist = p3.mdc_layer_nearest_wire(
+        np.array([0, 0, 0, -1, 43]),
+        np.array([np.nan, 10.0, np.inf, 10.0, 10.0]),
+        np.array([0.0, np.nan, 0.0, 0.0, 0.0]),
+        np.zeros(5),
+    )
+    assert np.all(res_gid == -1)
+    assert np.all(np.isnan(res_dist))
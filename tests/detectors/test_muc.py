@@ -0,0 +1,95 @@
+import awkward as ak
+import numpy as np
+import pytest
+
+import pybes3 as p3
+from pybes3 import muc
+from pybes3.identifier import get_muc_id, muc_id_to_gid, parse_muc_id
+
+
+def _ref_gid_table():
+    ref = {"part": [], "segment": [], "gap": [], "strip": []}
+    for part in range(muc.N_PARTS):
+        for segment in range(muc.N_SEGMENTS[part]):
+            for gap in range(muc.N_GAPS[part]):
+                if part != 1:
+                    n_strips = muc.ENDCAP_STRIPS
+                elif gap % 2 == 0:
+                    n_strips = muc.BARREL_Z_STRIPS
+                elif segment == muc.BARREL_TOP_SEGMENT:
+                    n_strips = muc.BARREL_TOP_PHI_STRIPS
+                else:
+                    n_strips = muc.BARREL_PHI_STRIPS
+
+                for strip in range(n_strips):
+                    ref["part"].append(part)
+                    ref["segment"].append(segment)
+                    ref["gap"].append(gap)
+                    ref["strip"].append(strip)
+    return {k: np.array(v) for k, v in ref.items()}
+
+
+def test_muc_gid_conversion():
+    ref = _ref_gid_table()
+    gid = np.arange(muc.N_STRIPS)
+    assert len(ref["part"]) == muc.N_STRIPS
+
+    assert np.all(p3.muc_gid_to_part(gid) == ref["part"])
+    assert np.all(p3.muc_gid_to_segment(gid) == ref["segment"])
+    assert np.all(p3.muc_gid_to_gap(gid) == ref["gap"])
+    assert np.all(p3.muc_gid_to_strip(gid) == ref["strip"])
+    assert np.all(p3.muc_gid_to_is_barrel(gid) == (ref["part"] == 1))
+    assert np.all(p3.get_muc_gid(ref["part"], ref["segment"], ref["gap"], ref["strip"]) == gid)
+
+    # scalar
+    assert p3.get_muc_gid(1, 2, 1, 111) == 2048 + 2 * (5 * 48 + 4 * 96) + 48 + 111
+
+    # awkward
+    ak_gid = ak.Array([gid[:100], gid[100:]])
+    ak_res = p3.parse_muc_gid(ak_gid)
+    assert ak_res.fields == ["part", "segment", "gap", "strip"]
+    assert ak.all(ak.flatten(ak_res["gap"]) == ref["gap"])
+
+    # digi ID
+    muc_id = get_muc_id(ref["part"], ref["segment"], ref["gap"], ref["strip"])
+    assert np.all(muc_id_to_gid(muc_id) == gid)
+    assert np.all(parse_muc_id(muc_id)["gid"] == gid)
+
+    # out-of-range fields give -1
+    bad_id = get_muc_id([3, 0, 1, 1], [0, 4, 0, 0], [0, 0, 9, 0], [0, 0, 0, 48])
+    assert np.all(muc_id_to_gid(bad_id) == -1)
+    assert np.all(parse_muc_id(bad_id)["gid"] == -1)
+
+
+@pytest.fixture
+def restore_muc_geom():
+    all_gid = np.arange(muc.N_STRIPS)
+    saved = [
+        f(all_gid)
+        for f in (
+            p3.muc_gid_to_center_x,
+            p3.muc_gid_to_center_y,
+            p3.muc_gid_to_center_z,
+            p3.muc_gid_to_dir_x,
+            p3.muc_gid_to_dir_y,
+            p3.muc_gid_to_dir_z,
+            p3.muc_gid_to_length,
+        )
+    ]
+    yield
+    p3.init_muc_geom(*saved)
+
+
+def test_muc_geom(restore_muc_geom):
+    gid = np.array([0, 3000, 9151])
+    assert np.all(np.isnan(p3.muc_gid_to_center_x(gid)))
+
+    values = [np.arange(muc.N_STRIPS) + 0.1 * i for i in range(7)]
+    p3.init_muc_geom(*values)
+    assert np.allclose(p3.muc_gid_to_center_x(gid), values[0][gid])
+    assert np.allclose(p3.muc_gid_to_center_y(gid), values[1][gid])
+    assert np.allclose(p3.muc_gid_to_center_z(gid), values[2][gid])
+    assert np.allclose(p3.muc_gid_to_dir_x(gid), values[3][gid])
+    assert np.allclose(p3.muc_gid_to_dir_y(gid), values[4][gid])
+    assert np.allclose(p3.muc_gid_to_dir_z(gid), values[5][gid])
+    assert np.allclose(p3.muc_gid_to_length(gid), values[6][gid])
@@ -2,10 +2,12 @@ from pathlib import Path
 
 import awkward as ak
 import numpy as np
+import pytest
 import uproot
 
 import pybes3 as p3
 from pybes3 import tof
+from pybes3.identifier import get_tof_id
 
 
 def test_tof_gid_conversion(tof_gid_dict):
@@ -85,3 +87,105 @@ def test_tof_hit_status(test_data_dir: Path):
     scalar_parsed = p3.parse_tof_hit_status(s)
     for f in fields:
         assert scalar_parsed[f] == flat_expected[f][0]
+
+
+def test_pair_tof_ends():
+    east = get_tof_id(1, 0, 10, 0)
+    west = get_tof_id(1, 0, 10, 1)
+    mrpc = get_tof_id(3, 2, 5, 1)
+
+    tof_id = ak.Array([[west, mrpc, east, east], []])
+    tdc = ak.Array([[12.0, 3.0, 14.0, 20.0], []])
+    adc = ak.Array([[100.0, 4.0, 400.0, 400.0], []])
+    overflow = ak.Array([[False, False, True, False], []])
+
+    hits = p3.pair_tof_ends(tof_id, tdc, adc, overflow, v_eff=15.0, time_walk=2.0)
+    assert ak.num(hits).tolist() == [2, 0]
+    assert hits.gid.tolist() == [[p3.get_tof_gid(1, 0, 10), p3.get_tof_gid(3, 2, 5)], []]
+
+    t_east, t_west = 14.0 - 2.0 / 20, 12.0 - 2.0 / 10
+    assert np.allclose(hits.time_east[0, 0], t_east)
+    assert np.allclose(hits.time_west[0, 0], t_west)
+    assert np.allclose(hits.time[0, 0], (t_east + t_west) / 2)
+    assert np.allclose(hits.z[0, 0], 7.5 * (t_west - t_east))
+    assert hits.is_overflow.tolist() == [[True, False], []]
+
+    assert np.isnan(hits.time_east[0, 1]) and np.isnan(hits.z[0, 1])
+    assert np.allclose(hits.time[0, 1], 3.0 - 2.0 / 2)
+
+
+@pytest.fixture
+def restore_tof_geom():
+    all_gid = np.arange(tof.N_STRIPS)
+    saved = [
+        f(all_gid)
+        for f in (
+            p3.tof_gid_to_center_x,
+            p3.tof_gid_to_center_y,
+            p3.tof_gid_to_center_z,
+            p3.tof_gid_to_phi_min,
+            p3.tof_gid_to_phi_max,
+            p3.tof_gid_to_z_min,
+            p3.tof_gid_to_z_max,
+            p3.tof_gid_to_r_min,
+            p3.tof_gid_to_r_max,
+        )
+    ]
+    yield
+    p3.init_tof_geom(*saved)
+
+
+def test_tof_geom_and_prediction(restore_tof_geom):
+    gid = np.array([0, 500, 1135])
+    assert np.all(np.isnan(p3.tof_gid_to_center_x(gid)))
+    assert np.all(p3.predict_tof_counters(85.0, 0.0, 0.0) == -1)
+
+    # one counter per phi slice, all in the same z and r range
+    width = 2 * np.pi / tof.N_STRIPS
+    phi_min = np.arange(tof.N_STRIPS) * width
+    phi_max = phi_min + width
+    phi_center = phi_min + width / 2
+    z_min, z_max = np.full(tof.N_STRIPS, -10.0), np.full(tof.N_STRIPS, 10.0)
+    r_min, r_max = np.full(tof.N_STRIPS, 80.0), np.full(tof.N_STRIPS, 90.0)
+    center_x, center_y = 85 * np.cos(phi_center), 85 * np.sin(phi_center)
+    center_z = np.zeros(tof.N_STRIPS)
+
+    p3.init_tof_geom(
+        center_x, center_y, center_z, phi_min, phi_max, z_min, z_max, r_min, r_max
+    )
+    assert np.allclose(p3.tof_gid_to_center_x(gid), center_x[gid])
+    assert np.allclose(p3.tof_gid_to_center_y(gid), center_y[gid])
+    assert np.allclose(p3.tof_gid_to_center_z(gid), center_z[gid])
+    assert np.allclose(p3.tof_gid_to_phi_min(gid), phi_min[gid])
+    assert np.allclose(p3.tof_gid_to_phi_max(gid), phi_max[gid])
+    assert np.allclose(p3.tof_gid_to_z_min(gid), z_min[gid])
+    assert np.allclose(p3.tof_gid_to_z_max(gid), z_max[gid])
+    assert np.allclose(p3.tof_gid_to_r_min(gid), r_min[gid])
+    assert np.allclose(p3.tof_gid_to_r_max(gid), r_max[gid])
+
+    phi = (gid + 0.3) * width
+    x, y, z = 85 * np.cos(phi), 85 * np.sin(phi), np.zeros(3)
+
+    # without tolerance, only the counter containing the point
+    res = p3.predict_tof_counters(x, y, z, k=2)
+    assert res.shape == (3, 2)
+    assert np.all(res[:, 0] == gid)
+    assert np.all(res[:, 1] == -1)
+
+    # neighbours within the phi tolerance, sorted by distance, wrapping around 2 * pi
+    res = p3.predict_tof_counters(x, y, z, k=3, phi_tolerance=width)
+    assert np.all(res[:, 0] == gid)
+    assert np.all(res[:, 1] == (gid - 1) % tof.N_STRIPS)
+    assert np.all(res[:, 2] == (gid + 1) % tof.N_STRIPS)
+
+    # outside the counters in z and r
+    res = p3.predict_tof_counters(x, y, z + 20, k=2, z_tolerance=5)
+    assert np.all(res == -1)
+    res = p3.predict_tof_counters(x * 1.1, y * 1.1, z, k=2, r_tolerance=5)
+    assert np.all(res[:, 0] == gid)
+
+    # awkward input
+    ak_x = ak.Array([x[:2].tolist(), [], x[2:].tolist()])
+    ak_y = ak.Array([y[:2].tolist(), [], y[2:].tolist()])
+    res = p3.predict_tof_counters(ak_x, ak_y, 0.0, k=2)
+    assert res.tolist() == [[[0, -1], [500, -1]], [], [[1135, -1]]]
@@ -1,4 +1,5 @@
 import awkward as ak
+import numpy as np
 import pytest
 import uproot
 
@@ -69,6 +70,82 @@ def test_cgem_rec(test_data_dir):
     assert ak.array_equal(arr, truth_arr, equal_nan=True)
 
 
+def test_cgem_cluster_fixed_size_fields(test_data_dir):
+    f_dst = uproot.open(test_data_dir / "test_cgem.rec")
+    clusters = f_dst["Event/TRecEvent/m_recCgemClusterCol"].array()
+
+    n = int(ak.count(clusters["m_clusterid"]))
+    assert n > 0
+
+    # m_clusterflag is int[2], m_stripid is int[2][2] of each cluster
+    cluster_flag = ak.to_numpy(ak.flatten(clusters["m_clusterflag"]))
+    strip_id = ak.to_numpy(ak.flatten(clusters["m_stripid"]))
+    assert cluster_flag.shape == (n, 2)
+    assert strip_id.shape == (n, 2, 2)
+    assert strip_id.reshape(n, -1).shape == (n, 4)
+
+
+def test_evt_navigator(test_data_dir):
+    evt = uproot.open(test_data_dir / "test_full_mc_evt_1.dst")["Event"]
+    truth_arr = ak.from_parquet(test_data_dir / "test_full_mc_evt_1.dst.parquet")
+
+    for name in ["m_mcMdcMcHits", "m_mcMdcTracks", "m_mcEmcMcHits", "m_mcEmcRecShowers"]:
+        arr = evt[f"EventNavigator/{name}"].array()
+        assert arr.fields == ["key", "val"]
+        assert ak.array_equal(arr, truth_arr[name])
+
+
+def test_root_offsets_int64(test_data_dir):
+    evt = uproot.open(test_data_dir / "test_full_mc_evt_1.dst")["Event"]
+
+    arr = evt["TDstEvent/m_mdcTrackCol"].array()
+    assert arr.layout.offsets.data.dtype == np.int64
+
+    arr = evt["EventNavigator/m_mcMdcTracks"].array()
+    assert arr.layout.offsets.data.dtype == np.int64
+
+
+def test_native_decompression(test_data_dir):
+    if "ZLIB" not in p3.io.root_io.native_decompression_algorithms():
+        pytest.skip("ZLIB is not supported by native decompression")
+
+    truth_arr = ak.from_parquet(test_data_dir / "test_full_mc_evt_1.dst.parquet")
+
+    p3.io.root_io.enable_native_decompression()
+    try:
+        arr = uproot.open(test_data_dir / "test_full_mc_evt_1.dst")["Event"].arrays()
+    finally:
+        p3.io.root_io.enable_native_decompression(False)
+
+    assert len(arr) == 10
+    assert ak.array_equal(arr, truth_arr, equal_nan=True)
+
+
+def test_native_decompression_algorithms():
+    from pybes3.kernels import _io
+
+    data = np.tile(np.arange(1000, dtype=np.int64), 100).tobytes()
+
+    n_tested = 0
+    for name in ["ZLIB", "LZMA", "LZ4", "ZSTD"]:
+        if name not in p3.io.root_io.native_decompression_algorithms():
+            continue
+
+        try:
+            compression = getattr(uproot.compression, name)(4)
+            compressed = uproot.compression.compress(data, compression)
+        except ImportError:
+            continue  # codec is not installed for uproot
+
+        assert compressed[:2] == p3.io.root_io._compression_headers[name]
+        res = _io.decompress(np.frombuffer(compressed, dtype=np.uint8), len(data))
+        assert res.tobytes() == data
+        n_tested += 1
+
+    if n_tested == 0:
+        pytest.skip("No compression algorithm is available in both uproot and pybes3")
+
+
 def test_uproot_concatenate(test_data_dir):
     arr_concat1 = uproot.concatenate(
         {
@@ -204,6 +281,14 @@ def test_RawBinaryParser_context(test_data_dir):
         assert len(arr) == 10
 
 
+def test_raw_offsets_int64(test_data_dir):
+    with p3.open_raw(test_data_dir / "test_raw_data.raw") as f:
+        arr = f.arrays()
+
+    for field in ["cgem", "mdc", "tof", "emc", "muc", "trigGTD"]:
+        assert arr[field].layout.offsets.data.dtype == np.int64
+
+
 def test_concatenate_raw(test_data_dir):
     f_test = test_data_dir / "test_raw_data.raw"
     files = [f_test, f_test, f_test]
@@ -233,6 +318,60 @@ def test_concatenate_raw(test_data_dir):
     assert len(arr) == 0
 
 
+def test_disk_array_cache_root(test_data_dir, tmp_path):
+    cache = p3.io.DiskArrayCache(tmp_path)
+    f_dst = uproot.open(test_data_dir / "test_full_mc_evt_1.dst", array_cache=cache)
+
+    arr1 = f_dst["Event/TDstEvent/m_mdcTrackCol"].array()
+    assert len(cache) > 0
+
+    arr2 = f_dst["Event/TDstEvent/m_mdcTrackCol"].array()
+    assert ak.array_equal(arr1, arr2, equal_nan=True)
+
+    # cache is persistent across file objects
+    cache2 = p3.io.DiskArrayCache(tmp_path)
+    f_dst2 = uproot.open(test_data_dir / "test_full_mc_evt_1.dst", array_cache=cache2)
+    arr3 = f_dst2["Event/TDstEvent/m_mdcTrackCol"].array()
+    assert ak.array_equal(arr1, arr3, equal_nan=True)
+
+
+def test_disk_array_cache_raw(test_data_dir, tmp_path):
+    f_test = test_data_dir / "test_raw_data.raw"
+    cache = p3.io.DiskArrayCache(tmp_path)
+
+    ref_arr = p3.open_raw(f_test).arrays(entry_start=2, entry_stop=7)
+
+    with p3.open_raw(f_test, array_cache=cache) as f:
+        arr1 = f.arrays(entry_start=2, entry_stop=7)
+    assert len(cache) == 1
+
+    with p3.open_raw(f_test, array_cache=cache) as f:
+        arr2 = f.arrays(entry_start=2, entry_stop=7)
+        arr3 = f.arrays(entry_start=2, entry_stop=7, filter_name="mdc")
+    assert len(cache) == 2
+
+    assert ak.array_equal(arr1, ref_arr, equal_nan=True)
+    assert ak.array_equal(arr2, ref_arr, equal_nan=True)
+    assert arr3.fields == ["evt_header", "mdc"]
+
+    cache.clear()
+    assert len(cache) == 0
+
+
+def test_disk_array_cache_version(tmp_path, monkeypatch):
+    cache = p3.io.DiskArrayCache(tmp_path)
+    cache["key"] = ak.Array([[1, 2], [], [3]])
+    assert cache["key"].tolist() == [[1, 2], [], [3]]
+
+    # entries written by another release are not served
+    monkeypatch.setattr(p3.io.cache, "__version__", "0.0.0")
+    assert "key" not in cache
+    assert len(cache) == 0
+
+    cache["key"] = ak.Array([[4]])
+    assert cache["key"].tolist() == [[4]]
+
+
 if __name__ == "__main__":
     import pytest
 
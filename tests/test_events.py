@@ -0,0 +1,67 @@
+import awkward as ak
+import numpy as np
+import pytest
+
+import pybes3 as p3
+from pybes3 import identifier
+
+
+def test_reduce_events():
+    values = ak.Array([[1.0, 3.0, 2.0], [], [5.0, np.nan, -1.0, 4.0], [np.nan]])
+
+    nan = np.nan
+    np.testing.assert_array_equal(p3.reduce_events(values, "sum"), [6.0, 0.0, nan, nan])
+    np.testing.assert_array_equal(p3.reduce_events(values, "min"), [1.0, nan, -1.0, nan])
+    np.testing.assert_array_equal(p3.reduce_events(values, "max"), [3.0, nan, 5.0, nan])
+    assert p3.reduce_events(values, "argmin").tolist() == [0, -1, 2, -1]
+    assert p3.reduce_events(values, "argmax").tolist() == [1, -1, 0, -1]
+    assert p3.reduce_events(values, "count").tolist() == [3, 0, 4, 1]
+
+    # grouped by key, keys out of range are skipped
+    key = ak.Array([[0, 1, 1], [], [2, 0, 0, -1], [1]])
+    np.testing.assert_array_equal(
+        p3.reduce_events(values, "sum", key=key, n_keys=2),
+        [[1.0, 5.0], [0.0, 0.0], [nan, 0.0], [0.0, nan]],
+    )
+    assert p3.reduce_events(values, "argmax", key=key).tolist() == [
+        [0, 1, -1],
+        [-1, -1, -1],
+        [2, -1, 0],
+        [-1, -1, -1],
+    ]
+    assert p3.reduce_events(None, "count", key=key).tolist() == [
+        [1, 2, 0],
+        [0, 0, 0],
+        [2, 0, 1],
+        [0, 1, 0],
+    ]
+
+    with pytest.raises(ValueError):
+        p3.reduce_events(values, "mean")
+    with pytest.raises(ValueError):
+        p3.reduce_events(None, "sum", key=key)
+    with pytest.raises(ValueError):
+        p3.reduce_events(values, "sum", n_keys=2)
+    with pytest.raises(ValueError):
+        p3.reduce_events(values, "sum", key=ak.Array([[0, 1], [0], [0, 0, 0, 0], [0]]))
+
+
+def test_reduce_events_mdc(digi_event):
+    mdc_gid = identifier.mdc_id_to_gid(digi_event["m_mdcDigiCol"]["m_intId"])
+    superlayer = p3.mdc_gid_to_superlayer(mdc_gid)
+    n_superlayers = 12
+
+    n_hits = p3.reduce_events(None, "count", key=superlayer, n_keys=n_superlayers)
+    assert n_hits.shape == (len(mdc_gid), n_superlayers)
+    for i in range(n_superlayers):
+        assert np.all(n_hits[:, i] == ak.sum(superlayer == i, axis=1).to_numpy())
+
+    values = ak.values_astype(mdc_gid, np.float64)
+    assert np.allclose(p3.reduce_events(values, "sum"), ak.sum(values, axis=1).to_numpy())
+    assert np.all(
+        p3.reduce_events(values, "argmax") == ak.fill_none(ak.argmax(values, axis=1), -1)
+    )
+    np.testing.assert_array_equal(
+        p3.reduce_events(values, "max", key=superlayer, n_keys=n_superlayers)[:, 0],
+        ak.fill_none(ak.max(values[superlayer == 0], axis=1), np.nan).to_numpy(),
+    )
@@ -56,6 +56,53 @@ def test_mdc_id(digi_event):
     assert identifier.check_mdc_id(tmp_id)
 
 
+def test_strided_input(digi_event):
+    mdc_id = ak.flatten(digi_event["m_mdcDigiCol"]["m_intId"]).to_numpy()
+
+    # contiguous and strided inputs go through different loops
+    for func in [
+        identifier.mdc_id_to_wire,
+        identifier.mdc_id_to_layer,
+        identifier.mdc_id_to_gid,
+    ]:
+        assert np.all(func(mdc_id[::2]) == func(mdc_id)[::2])
+        assert np.all(func(mdc_id[::-1]) == func(mdc_id)[::-1])
+
+
+def test_apply_jagged(digi_event):
+    from pybes3._utils import _apply_jagged
+    from pybes3.kernels import ufuncs
+
+    mdc_id = digi_event["m_mdcDigiCol"]["m_intId"]
+
+    # jagged inputs run on the flat buffer, results keep the original structure
+    layer, wire, is_stereo = _apply_jagged(ufuncs.parse_mdc_id, mdc_id)
+    assert ak.array_equal(layer, identifier.mdc_id_to_layer(mdc_id))
+    assert ak.array_equal(wire, identifier.mdc_id_to_wire(mdc_id))
+    assert ak.array_equal(is_stereo, identifier.mdc_id_to_is_stereo(mdc_id))
+
+    # gids of mdc_id_to_gid are int64, those of get_mdc_gid keep the dtype of the inputs
+    gid = _apply_jagged(ufuncs.get_mdc_gid, layer, wire)
+    mdc_gid = identifier.mdc_id_to_gid(mdc_id)
+    assert ak.flatten(mdc_gid).to_numpy().dtype == np.int64
+    assert ak.array_equal(ak.values_astype(gid, np.int64), mdc_gid)
+
+    # sliced and nested arrays
+    assert ak.array_equal(
+        _apply_jagged(ufuncs.mdc_id_to_wire, mdc_id[1:]), identifier.mdc_id_to_wire(mdc_id[1:])
+    )
+    nested = ak.unflatten(mdc_id, 1)
+    assert ak.array_equal(
+        _apply_jagged(ufuncs.mdc_id_to_wire, nested), identifier.mdc_id_to_wire(nested)
+    )
+
+    # different structures fall back to awkward broadcasting
+    assert ak.array_equal(
+        _apply_jagged(ufuncs.get_mdc_gid, layer[:, :1], ak.firsts(wire)),
+        p3.get_mdc_gid(layer[:, :1], ak.firsts(wire)),
+    )
+
+
 def test_parse_mdc_id(digi_event):
     mdc_id_ak: ak.Array = digi_event["m_mdcDigiCol"]["m_intId"]
     mdc_fields = ["gid", "layer", "wire", "is_stereo"]
@@ -827,6 +874,118 @@ def test_parse_cgem_digi_raw(raw_event):
         assert np.asarray(np_res[field]).ndim == 1
 
 
+def test_decode_digi_id(digi_event, cgem_digi_event):
+    detectors = {
+        identifier.DIGI_DETECTOR_MDC: (
+            digi_event["m_mdcDigiCol"]["m_intId"],
+            identifier.mdc_id_to_gid,
+        ),
+        identifier.DIGI_DETECTOR_TOF: (
+            digi_event["m_tofDigiCol"]["m_intId"],
+            identifier.tof_id_to_gid,
+        ),
+        identifier.DIGI_DETECTOR_EMC: (
+            digi_event["m_emcDigiCol"]["m_intId"],
+            identifier.emc_id_to_gid,
+        ),
+        identifier.DIGI_DETECTOR_MUC: (
+            digi_event["m_mucDigiCol"]["m_intId"],
+            identifier.muc_id_to_gid,
+        ),
+        identifier.DIGI_DETECTOR_CGEM: (
+            cgem_digi_event["m_cgemDigiCol"]["m_intId"],
+            identifier.cgem_id_to_gid,
+        ),
+    }
+
+    # mixed numpy array
+    ids, expected_det, expected_gid = [], [], []
+    for det, (digi_id, to_gid) in detectors.items():
+        flat_id = ak.flatten(digi_id).to_numpy()
+        ids.append(flat_id)
+        expected_det.append(np.full(len(flat_id), det))
+        expected_gid.append(to_gid(flat_id))
+
+    mixed_id = np.concatenate(ids + [np.array([0, 0x12345678], dtype=np.uint32)])
+    decoded = identifier.decode_digi_id(mixed_id)
+    assert np.all(decoded["detector"][:-2] == np.concatenate(expected_det))
+    assert np.all(decoded["gid"][:-2] == np.concatenate(expected_gid))
+    assert np.all(decoded["detector"][-2:] == identifier.DIGI_DETECTOR_UNKNOWN)
+    assert np.all(decoded["gid"][-2:] == -1)
+
+    # sub-fields are the same as parse_xxx_id
+    mdc = decoded["detector"] == identifier.DIGI_DETECTOR_MDC
+    mdc_parsed = identifier.parse_mdc_id(mixed_id[mdc])
+    assert np.all(decoded["field0"][mdc] == mdc_parsed["layer"])
+    assert np.all(decoded["field1"][mdc] == mdc_parsed["wire"])
+    assert np.all(decoded["field2"][mdc] == mdc_parsed["is_stereo"])
+    assert np.all(decoded["field3"][mdc] == -1)
+
+    tof = decoded["detector"] == identifier.DIGI_DETECTOR_TOF
+    tof_parsed = identifier.parse_tof_id(mixed_id[tof])
+    for i, field in enumerate(["part", "layer_or_module", "phi_or_strip", "end"]):
+        assert np.all(decoded[f"field{i}"][tof] == tof_parsed[field])
+
+    # awkward array
+    mdc_id = digi_event["m_mdcDigiCol"]["m_intId"]
+    decoded_ak = identifier.decode_digi_id(mdc_id)
+    assert ak.all(decoded_ak["detector"] == identifier.DIGI_DETECTOR_MDC)
+    assert ak.all(decoded_ak["gid"] == identifier.mdc_id_to_gid(mdc_id))
+
+    # invalid channel of a known detector
+    bad_mdc_id = identifier.get_mdc_id(0, 43, 0)
+    assert identifier.decode_digi_id(bad_mdc_id)["gid"] == -1
+
+
+def test_decode_digi_id_agrees_with_id_to_gid():
+    rng = np.random.default_rng(42)
+    for flag, to_gid in [
+        (0x10, identifier.mdc_id_to_gid),
+        (0x20, identifier.tof_id_to_gid),
+        (0x30, identifier.emc_id_to_gid),
+        (0x40, identifier.muc_id_to_gid),
+        (0x60, identifier.cgem_id_to_gid),
+    ]:
+        # random low bits, including unused ones, must give the same gid in both
+        digi_id = (flag << 24) | rng.integers(0, 1 << 24, 100_000, dtype=np.uint32)
+        assert np.all(identifier.decode_digi_id(digi_id)["gid"] == to_gid(digi_id))
+
+    # scintillator ID with unused bits 9-13 set
+    assert identifier.tof_id_to_gid(0x20EF4C77) == -1
+    assert identifier.decode_digi_id(0x20EF4C77)["gid"] == -1
+
+
+def test_id_to_gid_invalid():
+    # IDs of other detectors
+    mdc_id = identifier.get_mdc_id(0, 0, 0)
+    assert identifier.mdc_id_to_gid(mdc_id) == 0
+    for func in [
+        identifier.tof_id_to_gid,
+        identifier.emc_id_to_gid,
+        identifier.muc_id_to_gid,
+        identifier.cgem_id_to_gid,
+    ]:
+        assert func(mdc_id) == -1
+
+    # channels out of range
+    assert identifier.mdc_id_to_gid(identifier.get_mdc_id(40, 0, 0)) == -1
+    assert identifier.mdc_id_to_gid(identifier.get_mdc_id(0, 43, 0)) == -1
+    assert identifier.tof_id_to_gid(identifier.get_tof_id(1, 0, 87, 1)) == 135
+    assert identifier.tof_id_to_gid(identifier.get_tof_id(1, 0, 88, 0)) == -1
+    assert identifier.tof_id_to_gid(identifier.get_tof_id(3, 36, 0, 0)) == -1
+    assert identifier.emc_id_to_gid(identifier.get_emc_id(0, 0, 64)) == -1
+    assert identifier.emc_id_to_gid(identifier.get_emc_id(1, 44, 0)) == -1
+    assert identifier.muc_id_to_gid(identifier.get_muc_id(3, 0, 0, 0)) == -1
+    assert identifier.cgem_id_to_gid(identifier.get_cgem_id(0, 1, 0, 0)) == -1
+    assert identifier.cgem_id_to_gid(identifier.get_cgem_id(0, 0, 0, 856)) == -1
+
+    # all types of inputs
+    mdc_ids = np.array([mdc_id, 0, 0xFFFFFFFF])
+    for dtype in [np.uint32, np.uint64, np.int64]:
+        assert identifier.mdc_id_to_gid(mdc_ids.astype(dtype)).tolist() == [0, -1, -1]
+    assert identifier.mdc_id_to_gid(-1) == -1
+
+
 if __name__ == "__main__":
     import pytest
 
@@ -0,0 +1,58 @@
+import awkward as ak
+import numpy as np
+import pytest
+
+import pybes3 as p3
+from pybes3 import identifier
+
+
+def test_channel_histogram():
+    h = p3.ChannelHistogram(10, bins=4, range=(0, 8))
+    h.fill([0, 1, 1, 12, -1], [1.0, 2.0, 9.0, 3.0, 3.0])
+    h.fill(ak.Array([[1], [], [2, 3]]), ak.Array([[-1.0], [], [8.0, np.nan]]))
+
+    assert h.occupancy.tolist() == [1, 3, 1, 1, 0, 0, 0, 0, 0, 0]
+    assert h.n_invalid == 2
+    assert h.hist[:4].tolist() == [[1, 0, 0, 0], [0, 1, 0, 0], [0, 0, 0, 1], [0, 0, 0, 0]]
+    assert h.underflow[:4].tolist() == [0, 1, 0, 0]
+    assert h.overflow[:4].tolist() == [0, 1, 0, 0]
+    assert np.allclose(h.edges, [0, 2, 4, 6, 8])
+
+    other = p3.ChannelHistogram(10, bins=4, range=(0, 8))
+    other.fill([0], [7.0])
+    h += other
+    res = h.to_numpy()
+    assert res["hist"][0].tolist() == [1, 0, 0, 1]
+    assert res["occupancy"][0] == 2
+
+    h.reset()
+    assert h.occupancy.sum() == 0 and h.hist.sum() == 0 and h.n_invalid == 0
+
+    with pytest.raises(ValueError):
+        p3.ChannelHistogram(10, bins=4)
+    with pytest.raises(ValueError):
+        h.fill([0])
+    with pytest.raises(ValueError):
+        h += p3.ChannelHistogram(10)
+
+
+def test_channel_histogram_mdc(digi_event):
+    mdc_digi = digi_event["m_mdcDigiCol"]
+    gid = identifier.mdc_id_to_gid(mdc_digi["m_intId"])
+    tdc = mdc_digi["m_timeChannel"]
+
+    h = p3.ChannelHistogram(p3.mdc.N_WIRES, bins=32, range=(0, 2**16))
+    h.fill(gid, tdc)
+
+    flat_gid = ak.flatten(gid).to_numpy()
+    flat_tdc = ak.flatten(tdc).to_numpy()
+    ref_hist = np.histogram2d(
+        flat_gid,
+        flat_tdc,
+        bins=(p3.mdc.N_WIRES, 32),
+        range=((0, p3.mdc.N_WIRES), (0, 2**16)),
+    )[0]
+
+    assert np.all(h.occupancy == np.bincount(flat_gid, minlength=p3.mdc.N_WIRES))
+    assert np.all(h.hist == ref_hist)
+    assert h.n_invalid == 0
@@ -357,5 +357,72 @@ def test_helix_awk_3(new_pivot, raw_helix_arr, raw_helix_err_arr):
     assert ak.all(np.isclose(helix_rec.radius, helix_arr.radius[0]))
 
 
+def test_helix_awk_change_pivot_vs_obj(flat_helix_arr, flat_helix_err_arr):
+    """Test that helix_awk.change_pivot agrees with helix_obj.change_pivot track by track."""
+    new_pivot = (3.0, -2.0, 5.0)
+    helix_arr = p3.helix_awk(helix=flat_helix_arr, error=flat_helix_err_arr)
+    new_arr = helix_arr.change_pivot(*new_pivot)
+
+    for i in range(len(flat_helix_arr)):
+        dr, phi0, kappa, dz, tanl = flat_helix_arr[i]
+        h = p3.helix_obj(dr, phi0, kappa, dz, tanl, error=flat_helix_err_arr[i].to_numpy())
+        h = h.change_pivot(*new_pivot)
+
+        assert np.isclose(new_arr[i].dr, h.dr)
+        assert np.isclose(new_arr[i].phi0, h.phi0)
+        assert np.isclose(new_arr[i].dz, h.dz)
+        assert np.allclose(new_arr[i].error.to_numpy(), h.error)
+
+
+def test_helix_kinematics(raw_helix_arr):
+    """Test helix_kinematics against the single-output conversion functions."""
+    dr, phi0, kappa, dz, tanl = (raw_helix_arr[..., i] for i in range(5))
+    pt, phi, pz, x, y, z, charge = p3.helix_kinematics(dr, phi0, kappa, dz, tanl)
+
+    assert ak.all(pt == p3.kappa_to_pt(kappa))
+    assert ak.all(phi == p3.phi0_to_phi(phi0))
+    assert ak.all(np.isclose(pz, p3.kappa_to_pt(kappa) * tanl))
+    assert ak.all(np.isclose(x, p3.dr_phi0_to_x(dr, phi0)))
+    assert ak.all(np.isclose(y, p3.dr_phi0_to_y(dr, phi0)))
+    assert ak.all(z == dz)
+    assert ak.all(charge == p3.kappa_to_charge(kappa))
+
+    # momentum and position properties only compute their own half
+    helix = p3.helix_awk(raw_helix_arr)
+    assert ak.all(helix.momentum.pt == pt)
+    assert ak.all(helix.momentum.phi == phi)
+    assert ak.all(helix.momentum.pz == pz)
+    assert ak.all(helix.position.x == x)
+    assert ak.all(helix.position.y == y)
+    assert ak.all(helix.position.z == z)
+
+
+def test_helix_extrapolation(raw_helix_arr, raw_helix_err_arr):
+    """Test extrapolate_to_cylinder and extrapolate_to_z_plane."""
+    helix = p3.helix_awk(raw_helix_arr, raw_helix_err_arr)
+
+    pos, mom, path, reached = helix.extrapolate_to_cylinder(81.0)
+    assert ak.all(reached == ~np.isnan(path))
+    assert ak.all(np.isclose(pos.rho[reached], 81.0))
+    assert ak.all(path[reached] >= 0)
+    assert ak.all(np.isclose(mom.pt[reached], helix.momentum.pt[reached]))
+    assert ak.all(np.isclose(mom.pz[reached], helix.momentum.pz[reached]))
+
+    pos, mom, path, reached = helix.extrapolate_to_z_plane(100.0)
+    assert ak.all(reached == (helix.tanl > 0))
+    assert ak.all(np.isclose(pos.z[reached], 100.0))
+
+    # 1 GeV/c track along y axis, bending towards +x
+    h0 = p3.helix_obj(0.0, 0.0, 1.0, 0.0, 0.0)
+    pos, mom, path, reached = h0.extrapolate_to_cylinder(81.0)
+    assert reached
+    assert np.isclose(pos.rho, 81.0)
+    assert pos.x > 0 and pos.y > 0
+    assert np.isclose(mom.pt, 1.0) and mom.px > 0
+
+    pos, mom, path, reached = h0.extrapolate_to_z_plane(100.0)
+    assert not reached
+
+
 if __name__ == "__main__":
     pytest.main([__file__, "-v", "-s"])